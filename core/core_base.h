@@ -43,6 +43,11 @@
 #define LINKEDLIST_IMPLEMENTATION
 #endif
 
+#include "./seakcutils/data_structures/ws_deque.h"
+#ifndef WS_DEQUE_IMPLEMENTATION
+#define WS_DEQUE_IMPLEMENTATION
+#endif
+
 #include "./seakcutils/channels/channels.h"
 #ifndef CHANNEL_BASICS_IMPLEMENTATION
 #define CHANNEL_BASICS_IMPLEMENTATION
@@ -58,11 +63,29 @@
 #define MPMC_IMPLEMENTATION
 #endif
 
+#include "./seakcutils/channels/unbounded.h"
+#ifndef UNBOUNDED_IMPLEMENTATION
+#define UNBOUNDED_IMPLEMENTATION
+#endif
+
+#include "./seakcutils/threadpool/topology.h"
+#ifndef TOPOLOGY_IMPLEMENTATION
+#define TOPOLOGY_IMPLEMENTATION
+#endif
+
 #include "./seakcutils/threadpool/threadpool.h"
 #ifndef THREADPOOL_IMPLEMENTATION
 #define THREADPOOL_IMPLEMENTATION
 #endif
 
+// job fibers (job_await suspends instead of helping), x86-64 only
+#if defined(JOBSYSTEM_FIBERS)
+#include "./seakcutils/yield/yield.h"
+#ifndef YIELD_IMPLEMENTATION
+#define YIELD_IMPLEMENTATION
+#endif
+#endif
+
 #include "./seakcutils/job_system/jobsystem.h"
 #ifndef JOBSYSTEM_IMPLEMENTATION
 #define JOBSYSTEM_IMPLEMENTATION
@@ -0,0 +1,527 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CHANNEL_BASICS_IMPLEMENTATION
+#include "../channels/channels.h"
+#define SPSC_IMPLEMENTATION
+#include "../channels/spsc.h"
+#define MPSC_IMPLEMENTATION
+#include "../channels/mpsc.h"
+#define SPMC_IMPLEMENTATION
+#include "../channels/spmc.h"
+#define MPMC_IMPLEMENTATION
+#include "../channels/mpmc.h"
+#define MCAST_IMPLEMENTATION
+#include "../channels/mcast.h"
+#define UNBOUNDED_IMPLEMENTATION
+#include "../channels/unbounded.h"
+
+/*
+ * Channel benchmark suite
+ * -----------------------------
+ * Runs every channel type across producer/consumer counts, element sizes
+ * and with/without thread pinning, one result line per configuration.
+ *
+ *   make bench-channels
+ *   make bench-channels BENCH_ARGS="--format json --msgs 2000000"
+ *
+ * Options:
+ *   --msgs N          messages per configuration (default 1000000)
+ *   --threads N       highest producer/consumer count (default: online cpus)
+ *   --capacity N      ring capacity for bounded channels (default 1024)
+ *   --format csv|json output format (default csv)
+ *   --only NAME       run a single channel (spsc, mpsc, spmc, mpmc, mcast,
+ *                     unbounded)
+ *
+ * Every message carries its send timestamp in the first 8 bytes. Latency
+ * is measured under load (queueing included) on every LATENCY_SAMPLE-th
+ * message a consumer receives; p50/p99/p999/max are reported.
+ *
+ * For mcast every consumer receives every message, mops counts deliveries.
+ * */
+
+#define LATENCY_SAMPLE 16
+#define COUNT_FLUSH 64
+
+static const size_t ELEM_SIZES[] = {8, 32, 64, 128, 256};
+#define NUM_ELEM_SIZES (sizeof(ELEM_SIZES) / sizeof(ELEM_SIZES[0]))
+
+/*---------------- channel adapters ----------------*/
+
+typedef struct BenchOps_t {
+  const char *name;
+  int multi_producer;
+  int multi_consumer;
+  int broadcast; // every consumer receives every message
+
+  void *(*create)(size_t capacity, size_t elem_size, size_t consumers);
+  void *(*get_sender)(void *chan);
+  void *(*get_receiver)(void *chan);
+  int (*send)(void *sender, const void *element);  // CHANNEL_ERR_FULL: retry
+  int (*recv)(void *receiver, void *out);          // CHANNEL_ERR_EMPTY: retry
+  void (*close_sender)(void *sender);
+  void (*close_receiver)(void *receiver);
+  void (*destroy)(void *chan);
+} BenchOps;
+
+static void noop_handle(void *handle) { (void)handle; }
+
+static void *spsc_create(size_t capacity, size_t elem_size, size_t consumers) {
+  (void)consumers;
+  return channel_create_spsc(capacity, elem_size);
+}
+static void *spsc_sender(void *chan) { return spsc_get_sender(chan); }
+static void *spsc_receiver(void *chan) { return spsc_get_receiver(chan); }
+static int spsc_send_op(void *s, const void *e) { return spsc_try_send(s, e); }
+static int spsc_recv_op(void *r, void *out) { return spsc_recv(r, out); }
+static void spsc_destroy_op(void *chan) { spsc_destroy(chan); }
+
+static void *mpsc_create(size_t capacity, size_t elem_size, size_t consumers) {
+  (void)consumers;
+  return channel_create_mpsc(capacity, elem_size);
+}
+static void *mpsc_sender(void *chan) { return mpsc_get_sender(chan); }
+static void *mpsc_receiver(void *chan) { return mpsc_get_receiver(chan); }
+static int mpsc_send_op(void *s, const void *e) { return mpsc_send(s, e); }
+static int mpsc_recv_op(void *r, void *out) { return mpsc_recv(r, out); }
+static void mpsc_close_sender_op(void *s) { mpsc_close_sender(s); }
+static void mpsc_destroy_op(void *chan) { mpsc_destroy(chan); }
+
+static void *spmc_create(size_t capacity, size_t elem_size, size_t consumers) {
+  (void)consumers;
+  return channel_create_spmc(capacity, elem_size);
+}
+static void *spmc_sender(void *chan) { return spmc_get_sender(chan); }
+static void *spmc_receiver(void *chan) { return spmc_get_receiver(chan); }
+static int spmc_send_op(void *s, const void *e) { return spmc_send(s, e); }
+static int spmc_recv_op(void *r, void *out) { return spmc_try_recv(r, out); }
+static void spmc_close_receiver_op(void *r) { spmc_close_receiver(r); }
+static void spmc_destroy_op(void *chan) { spmc_destroy(chan); }
+
+static void *mpmc_create(size_t capacity, size_t elem_size, size_t consumers) {
+  (void)consumers;
+  return channel_create_mpmc(capacity, elem_size);
+}
+static void *mpmc_sender(void *chan) { return mpmc_get_sender(chan); }
+static void *mpmc_receiver(void *chan) { return mpmc_get_receiver(chan); }
+static int mpmc_send_op(void *s, const void *e) { return mpmc_send(s, e); }
+static int mpmc_recv_op(void *r, void *out) { return mpmc_try_recv(r, out); }
+static void mpmc_close_sender_op(void *s) { mpmc_close_sender(s); }
+static void mpmc_close_receiver_op(void *r) { mpmc_close_receiver(r); }
+static void mpmc_destroy_op(void *chan) { mpmc_destroy(chan); }
+
+static void *mcast_create(size_t capacity, size_t elem_size, size_t consumers) {
+  return channel_create_mcast(capacity, elem_size, consumers);
+}
+static void *mcast_sender(void *chan) { return mcast_get_sender(chan); }
+static void *mcast_receiver(void *chan) {
+  return mcast_get_receiver(chan, NULL, 0);
+}
+static int mcast_send_op(void *s, const void *e) { return mcast_send(s, e); }
+static int mcast_recv_op(void *r, void *out) { return mcast_try_recv(r, out); }
+static void mcast_close_sender_op(void *s) { mcast_close_sender(s); }
+static void mcast_close_receiver_op(void *r) { mcast_close_receiver(r); }
+static void mcast_destroy_op(void *chan) { mcast_destroy(chan); }
+
+static void *unbounded_create(size_t capacity, size_t elem_size,
+                              size_t consumers) {
+  (void)capacity;
+  (void)consumers;
+  return channel_create_unbounded(elem_size);
+}
+static void *unbounded_sender(void *chan) { return unbounded_get_sender(chan); }
+static void *unbounded_receiver(void *chan) {
+  return unbounded_get_receiver(chan);
+}
+static int unbounded_send_op(void *s, const void *e) {
+  return unbounded_send(s, e);
+}
+static int unbounded_recv_op(void *r, void *out) {
+  return unbounded_try_recv(r, out);
+}
+static void unbounded_close_sender_op(void *s) { unbounded_close_sender(s); }
+static void unbounded_close_receiver_op(void *r) {
+  unbounded_close_receiver(r);
+}
+static void unbounded_destroy_op(void *chan) { unbounded_destroy(chan); }
+
+static const BenchOps BENCH_OPS[] = {
+    {"spsc", 0, 0, 0, spsc_create, spsc_sender, spsc_receiver, spsc_send_op,
+     spsc_recv_op, noop_handle, noop_handle, spsc_destroy_op},
+    {"mpsc", 1, 0, 0, mpsc_create, mpsc_sender, mpsc_receiver, mpsc_send_op,
+     mpsc_recv_op, mpsc_close_sender_op, noop_handle, mpsc_destroy_op},
+    {"spmc", 0, 1, 0, spmc_create, spmc_sender, spmc_receiver, spmc_send_op,
+     spmc_recv_op, noop_handle, spmc_close_receiver_op, spmc_destroy_op},
+    {"mpmc", 1, 1, 0, mpmc_create, mpmc_sender, mpmc_receiver, mpmc_send_op,
+     mpmc_recv_op, mpmc_close_sender_op, mpmc_close_receiver_op,
+     mpmc_destroy_op},
+    {"mcast", 0, 1, 1, mcast_create, mcast_sender, mcast_receiver,
+     mcast_send_op, mcast_recv_op, mcast_close_sender_op,
+     mcast_close_receiver_op, mcast_destroy_op},
+    {"unbounded", 1, 1, 0, unbounded_create, unbounded_sender,
+     unbounded_receiver, unbounded_send_op, unbounded_recv_op,
+     unbounded_close_sender_op, unbounded_close_receiver_op,
+     unbounded_destroy_op},
+};
+#define NUM_BENCH_OPS (sizeof(BENCH_OPS) / sizeof(BENCH_OPS[0]))
+
+/*---------------- run ----------------*/
+
+typedef struct BenchRun_t {
+  const BenchOps *ops;
+  void *chan;
+  size_t elem_size;
+  size_t producers;
+  size_t consumers;
+  size_t messages; // total sent
+  size_t capacity_hint; // ring capacity, ignored by unbounded
+  int pinned;
+  long num_cpus;
+
+  _Atomic size_t ready;
+  _Atomic int go;
+  _Atomic size_t received; // shared count, unused for broadcast
+} BenchRun;
+
+typedef struct BenchThread_t {
+  BenchRun *run;
+  size_t index; // producer or consumer index
+  size_t cpu;
+  void *handle;
+
+  uint64_t *samples;
+  size_t num_samples;
+  size_t max_samples;
+} BenchThread;
+
+static inline uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void pin_to(size_t cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static void wait_start(BenchThread *t) {
+  if (t->run->pinned) {
+    pin_to(t->cpu);
+  }
+  atomic_fetch_add_explicit(&t->run->ready, 1, memory_order_acq_rel);
+  while (!atomic_load_explicit(&t->run->go, memory_order_acquire)) {
+    cpu_relax();
+  }
+}
+
+static void *producer_fn(void *arg) {
+  BenchThread *t = arg;
+  BenchRun *run = t->run;
+  uint8_t msg[256];
+  memset(msg, (int)t->index, sizeof(msg));
+
+  size_t count = run->messages / run->producers;
+  if (t->index < run->messages % run->producers) {
+    count++;
+  }
+
+  wait_start(t);
+  for (size_t x = 0; x < count; x++) {
+    uint64_t ts = now_ns();
+    memcpy(msg, &ts, sizeof(ts));
+    while (run->ops->send(t->handle, msg) == CHANNEL_ERR_FULL) {
+      cpu_relax();
+    }
+  }
+  return NULL;
+}
+
+static void *consumer_fn(void *arg) {
+  BenchThread *t = arg;
+  BenchRun *run = t->run;
+  uint8_t msg[256];
+
+  size_t local = 0;   // received, not yet flushed to run->received
+  size_t mine = 0;    // received by this consumer
+  size_t sample = 0;
+
+  wait_start(t);
+  for (;;) {
+    int res = run->ops->recv(t->handle, msg);
+    if (res == CHANNEL_OK) {
+      mine++;
+      if (++sample == LATENCY_SAMPLE) {
+        sample = 0;
+        uint64_t ts;
+        memcpy(&ts, msg, sizeof(ts));
+        if (t->num_samples < t->max_samples) {
+          t->samples[t->num_samples++] = now_ns() - ts;
+        }
+      }
+      if (run->ops->broadcast) {
+        if (mine == run->messages) {
+          break;
+        }
+      } else if (++local == COUNT_FLUSH) {
+        atomic_fetch_add_explicit(&run->received, local, memory_order_relaxed);
+        local = 0;
+      }
+      continue;
+    }
+
+    if (res == CHANNEL_ERR_CLOSED) {
+      break;
+    }
+    // empty: publish the local count and check whether everything arrived
+    if (!run->ops->broadcast) {
+      if (local) {
+        atomic_fetch_add_explicit(&run->received, local, memory_order_relaxed);
+        local = 0;
+      }
+      if (atomic_load_explicit(&run->received, memory_order_relaxed) >=
+          run->messages) {
+        break;
+      }
+    }
+    cpu_relax();
+  }
+  if (local) {
+    atomic_fetch_add_explicit(&run->received, local, memory_order_relaxed);
+  }
+  return NULL;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const uint64_t *sorted, size_t n, double p) {
+  if (n == 0) {
+    return 0;
+  }
+  size_t idx = (size_t)(p * (double)(n - 1));
+  return sorted[idx];
+}
+
+typedef struct BenchResult_t {
+  double seconds;
+  double mops;
+  uint64_t p50, p99, p999, max;
+} BenchResult;
+
+static int bench_run(BenchRun *run, BenchResult *res) {
+  size_t nthreads = run->producers + run->consumers;
+  pthread_t *threads = malloc(nthreads * sizeof(pthread_t));
+  BenchThread *ts = calloc(nthreads, sizeof(BenchThread));
+
+  run->chan = run->ops->create(run->capacity_hint, run->elem_size,
+                               run->consumers);
+  if (!run->chan || !threads || !ts) {
+    free(threads);
+    free(ts);
+    return -1;
+  }
+  atomic_init(&run->ready, 0);
+  atomic_init(&run->go, 0);
+  atomic_init(&run->received, 0);
+
+  size_t per_consumer = run->ops->broadcast
+                            ? run->messages
+                            : run->messages / run->consumers + 1;
+  size_t max_samples = per_consumer / LATENCY_SAMPLE + 1;
+
+  // receivers first, multicast receivers must exist before anything is sent
+  for (size_t x = 0; x < nthreads; x++) {
+    BenchThread *t = &ts[x];
+    t->run = run;
+    t->cpu = (size_t)((long)x % run->num_cpus);
+    if (x < run->consumers) {
+      t->index = x;
+      t->handle = run->ops->get_receiver(run->chan);
+      t->max_samples = max_samples;
+      t->samples = malloc(max_samples * sizeof(uint64_t));
+    } else {
+      t->index = x - run->consumers;
+      t->handle = run->ops->get_sender(run->chan);
+    }
+  }
+  for (size_t x = 0; x < nthreads; x++) {
+    pthread_create(&threads[x], NULL,
+                   x < run->consumers ? consumer_fn : producer_fn, &ts[x]);
+  }
+  while (atomic_load_explicit(&run->ready, memory_order_acquire) != nthreads) {
+    sched_yield();
+  }
+
+  uint64_t start = now_ns();
+  atomic_store_explicit(&run->go, 1, memory_order_release);
+  for (size_t x = 0; x < nthreads; x++) {
+    pthread_join(threads[x], NULL);
+  }
+  uint64_t end = now_ns();
+
+  size_t total_samples = 0;
+  for (size_t x = 0; x < run->consumers; x++) {
+    total_samples += ts[x].num_samples;
+  }
+  uint64_t *all = malloc((total_samples + 1) * sizeof(uint64_t));
+  size_t n = 0;
+  for (size_t x = 0; x < run->consumers; x++) {
+    memcpy(all + n, ts[x].samples, ts[x].num_samples * sizeof(uint64_t));
+    n += ts[x].num_samples;
+  }
+  qsort(all, n, sizeof(uint64_t), cmp_u64);
+
+  size_t delivered =
+      run->ops->broadcast ? run->messages * run->consumers : run->messages;
+  res->seconds = (double)(end - start) / 1e9;
+  res->mops = ((double)delivered / res->seconds) / 1e6;
+  res->p50 = percentile(all, n, 0.50);
+  res->p99 = percentile(all, n, 0.99);
+  res->p999 = percentile(all, n, 0.999);
+  res->max = n ? all[n - 1] : 0;
+
+  for (size_t x = 0; x < nthreads; x++) {
+    if (x < run->consumers) {
+      run->ops->close_receiver(ts[x].handle);
+      free(ts[x].samples);
+    } else {
+      run->ops->close_sender(ts[x].handle);
+    }
+    free(ts[x].handle);
+  }
+  run->ops->destroy(run->chan);
+  free(all);
+  free(ts);
+  free(threads);
+  return 0;
+}
+
+/*---------------- driver ----------------*/
+
+typedef enum { FORMAT_CSV, FORMAT_JSON } OutputFormat;
+
+static void print_result(OutputFormat format, const BenchRun *run,
+                         const BenchResult *res) {
+  if (format == FORMAT_JSON) {
+    printf("{\"channel\":\"%s\",\"producers\":%zu,\"consumers\":%zu,"
+           "\"elem_size\":%zu,\"pinned\":%s,\"messages\":%zu,"
+           "\"seconds\":%.6f,\"mops\":%.3f,\"p50_ns\":%llu,\"p99_ns\":%llu,"
+           "\"p999_ns\":%llu,\"max_ns\":%llu}\n",
+           run->ops->name, run->producers, run->consumers, run->elem_size,
+           run->pinned ? "true" : "false", run->messages, res->seconds,
+           res->mops, (unsigned long long)res->p50,
+           (unsigned long long)res->p99, (unsigned long long)res->p999,
+           (unsigned long long)res->max);
+  } else {
+    printf("%s,%zu,%zu,%zu,%d,%zu,%.6f,%.3f,%llu,%llu,%llu,%llu\n",
+           run->ops->name, run->producers, run->consumers, run->elem_size,
+           run->pinned, run->messages, res->seconds, res->mops,
+           (unsigned long long)res->p50, (unsigned long long)res->p99,
+           (unsigned long long)res->p999, (unsigned long long)res->max);
+  }
+  fflush(stdout);
+}
+
+// 1, 2, 4, ... up to max, plus max itself
+static size_t thread_counts(size_t max, size_t *out) {
+  size_t n = 0;
+  for (size_t c = 1; c < max; c *= 2) {
+    out[n++] = c;
+  }
+  out[n++] = max;
+  return n;
+}
+
+int main(int argc, char **argv) {
+  size_t messages = 1000000;
+  size_t capacity = 1024;
+  long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  size_t max_threads = num_cpus > 0 ? (size_t)num_cpus : 1;
+  OutputFormat format = FORMAT_CSV;
+  const char *only = NULL;
+
+  for (int x = 1; x < argc; x++) {
+    if (!strcmp(argv[x], "--msgs") && x + 1 < argc) {
+      messages = strtoull(argv[++x], NULL, 10);
+    } else if (!strcmp(argv[x], "--threads") && x + 1 < argc) {
+      max_threads = strtoull(argv[++x], NULL, 10);
+    } else if (!strcmp(argv[x], "--capacity") && x + 1 < argc) {
+      capacity = strtoull(argv[++x], NULL, 10);
+    } else if (!strcmp(argv[x], "--format") && x + 1 < argc) {
+      format = strcmp(argv[++x], "json") ? FORMAT_CSV : FORMAT_JSON;
+    } else if (!strcmp(argv[x], "--only") && x + 1 < argc) {
+      only = argv[++x];
+    } else {
+      fprintf(stderr,
+              "usage: %s [--msgs N] [--threads N] [--capacity N] "
+              "[--format csv|json] [--only CHANNEL]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  if (max_threads == 0 || messages == 0 || capacity == 0) {
+    fprintf(stderr, "msgs, threads and capacity must be > 0\n");
+    return 1;
+  }
+  if (num_cpus <= 0) {
+    num_cpus = 1;
+  }
+
+  if (format == FORMAT_CSV) {
+    printf("channel,producers,consumers,elem_size,pinned,messages,seconds,"
+           "mops,p50_ns,p99_ns,p999_ns,max_ns\n");
+  }
+
+  size_t counts[64];
+  size_t num_counts = thread_counts(max_threads, counts);
+
+  for (size_t o = 0; o < NUM_BENCH_OPS; o++) {
+    const BenchOps *ops = &BENCH_OPS[o];
+    if (only && strcmp(only, ops->name)) {
+      continue;
+    }
+    for (size_t c = 0; c < num_counts; c++) {
+      // single-ended sides stay at 1, MPMC-style channels scale both
+      size_t producers = ops->multi_producer ? counts[c] : 1;
+      size_t consumers = ops->multi_consumer ? counts[c] : 1;
+      if (!ops->multi_producer && !ops->multi_consumer && c > 0) {
+        break;
+      }
+      for (size_t e = 0; e < NUM_ELEM_SIZES; e++) {
+        for (int pinned = 0; pinned < 2; pinned++) {
+          BenchRun run = {0};
+          run.ops = ops;
+          run.elem_size = ELEM_SIZES[e];
+          run.capacity_hint = capacity;
+          run.producers = producers;
+          run.consumers = consumers;
+          run.messages = messages;
+          run.pinned = pinned;
+          run.num_cpus = num_cpus;
+
+          BenchResult res;
+          if (bench_run(&run, &res) != 0) {
+            fprintf(stderr, "%s: setup failed\n", ops->name);
+            continue;
+          }
+          print_result(format, &run, &res);
+        }
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,577 @@
+// Copyright 2025 Seaker <seakerone@proton.me>
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+------------------------------------------------------------------------------
+bytes.h — Variable-length byte ring (Multi-Producer Single-Consumer)
+
+All other channels move fixed elem_size records. This one moves
+length-prefixed records of any size, so log lines, render commands or
+debug strings are sent densely instead of padded to the largest case or
+boxed behind a heap pointer.
+
+This channel supports:
+- multiple producers (a single producer works the same way: SPSC)
+- a single consumer
+- zero-copy reserve/commit and peek/release, plus copying send/recv
+- non-blocking operations only (CHANNEL_ERR_FULL / CHANNEL_ERR_EMPTY)
+
+------------------------------------------------------------------------------
+MEMORY LAYOUT ("magic ring")
+
+The ring is a memfd mapped twice, back to back:
+
+    [ ring (capacity bytes) ][ same pages again ]
+
+A record that starts near the end of the ring simply runs into the second
+mapping, which is the start of the ring. Records are therefore always
+contiguous: no split copies, no padding record at the wrap, and peek can
+hand out a plain pointer.
+
+Each record is an 8-byte header followed by the payload, rounded up to 8
+bytes:
+
+    header = payload length | BYTES_COMMITTED
+
+The header stays 0 until the producer commits (release store). The
+consumer zeroes every byte it consumed before moving the tail, so a
+producer claiming space always finds zeroed memory and a half-written
+record can never look committed.
+
+------------------------------------------------------------------------------
+PROPERTIES
+
+- Producers claim space with a CAS on head, then write in parallel
+- Commit order may differ from claim order; the consumer reads in claim
+  order (an uncommitted record holds back the ones behind it)
+- Producers cache the consumer tail and only reload it when the ring
+  looks full
+- Capacity is rounded up to a power of two multiple of the page size
+- Linux only (memfd_create + mmap)
+
+------------------------------------------------------------------------------
+LIFETIME
+
+1. channel_create_bytes()
+2. bytes_get_sender() (N times) / bytes_get_receiver() (once)
+3. bytes_send() or bytes_reserve() + bytes_commit()
+   bytes_recv() or bytes_peek()    + bytes_release()
+4. bytes_close()
+5. bytes_close_sender()
+6. bytes_destroy()
+
+Senders and receivers must be freed by the user.
+------------------------------------------------------------------------------
+*/
+#ifndef BYTES_CHANNEL_H
+#define BYTES_CHANNEL_H
+
+/*-------------------------------------------*/
+/*      Platform-dependent cpu_relax()       */
+/*-------------------------------------------*/
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+#define cpu_relax() _mm_pause()
+/*-------------------------------------------*/
+#elif defined(__aarch64__) || defined(__arm__)
+
+#define cpu_relax() __asm__ __volatile__("yield")
+/*-------------------------------------------*/
+#elif defined(__riscv)
+
+#define cpu_relax() __asm__ __volatile__("pause")
+/*-------------------------------------------*/
+#else
+#define cpu_relax() ((void)0)
+#endif
+/*-------------------------------------------*/
+
+#include <stddef.h>
+
+typedef struct ChannelBytes_t ChannelBytes;
+typedef enum ChanState_t ChanState;
+
+/*-----------------------------------------------------------------------------
+  channel_create_bytes
+  Allocates and maps a new byte ring.
+
+  capacity : ring size in bytes, rounded up to a power of two multiple of
+             the page size
+
+  Returns a pointer to ChannelBytes on success, NULL on failure.
+
+  Notes:
+    - The largest record payload is capacity - 8 bytes.
+-----------------------------------------------------------------------------*/
+ChannelBytes *channel_create_bytes(const size_t capacity);
+
+/*-----------------------------------------------------------------------------
+  bytes_close / bytes_is_closed
+  Marks the channel as closed / checks whether it is.
+
+  Notes:
+    - After closing, bytes_send and bytes_reserve return CHANNEL_ERR_CLOSED.
+    - The consumer may continue to drain the ring until empty.
+-----------------------------------------------------------------------------*/
+void bytes_close(ChannelBytes *chan);
+ChanState bytes_is_closed(const ChannelBytes *chan);
+
+/*-----------------------------------------------------------------------------
+  bytes_set_signal
+  Attaches a ChannelSignal that senders bump after each commit and on close.
+
+  chan : pointer to the channel
+  sig  : signal to attach, NULL to detach
+-----------------------------------------------------------------------------*/
+void bytes_set_signal(ChannelBytes *chan, ChannelSignal *sig);
+
+/*-----------------------------------------------------------------------------
+  bytes_destroy
+  Unmaps the ring and frees the channel.
+
+  Notes:
+    - Blocks until all senders are closed.
+-----------------------------------------------------------------------------*/
+void bytes_destroy(ChannelBytes *chan);
+
+typedef struct SenderBytes_t SenderBytes;
+typedef struct ReceiverBytes_t ReceiverBytes;
+
+/*-----------------------------------------------------------------------------
+  bytes_get_sender / bytes_get_receiver
+  Allocate and return a producer / consumer handle.
+
+  Notes:
+    - Any number of senders, exactly ONE receiver.
+-----------------------------------------------------------------------------*/
+SenderBytes *bytes_get_sender(ChannelBytes *chan);
+ReceiverBytes *bytes_get_receiver(ChannelBytes *chan);
+
+/*-----------------------------------------------------------------------------
+  bytes_close_sender
+  Marks the sender as closed and decrements the channel's producer count.
+-----------------------------------------------------------------------------*/
+void bytes_close_sender(SenderBytes *sender);
+
+/*-----------------------------------------------------------------------------
+  bytes_reserve
+  Claims space for a record of `len` bytes and exposes it for in-place
+  writing.
+
+  sender : pointer to a valid SenderBytes
+  len    : payload size in bytes
+  data   : receives a pointer to len writable (contiguous) bytes
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if an argument is NULL or len does not fit the ring
+    - CHANNEL_ERR_FULL    if there is not enough free space right now, or a
+                          reservation is already pending on this sender
+    - CHANNEL_ERR_CLOSED  if channel is closed
+
+  Notes:
+    - Must be followed by bytes_commit; records behind it wait until then.
+-----------------------------------------------------------------------------*/
+int bytes_reserve(SenderBytes *sender, size_t len, void **data);
+
+/*-----------------------------------------------------------------------------
+  bytes_commit
+  Publishes the record claimed by the last bytes_reserve.
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if sender is NULL or nothing is reserved
+-----------------------------------------------------------------------------*/
+int bytes_commit(SenderBytes *sender);
+
+/*-----------------------------------------------------------------------------
+  bytes_send
+  Copies `len` bytes from data into a new record (reserve + memcpy + commit).
+
+  Returns the same codes as bytes_reserve.
+-----------------------------------------------------------------------------*/
+int bytes_send(SenderBytes *sender, const void *data, size_t len);
+
+/*-----------------------------------------------------------------------------
+  bytes_peek
+  Exposes the oldest committed record in place.
+
+  receiver : pointer to a valid ReceiverBytes
+  data     : receives a pointer to the payload
+  len      : receives the payload size
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if an argument is NULL
+    - CHANNEL_ERR_EMPTY   if the next record is not committed yet
+    - CHANNEL_ERR_CLOSED  if channel is closed and drained
+
+  Notes:
+    - Must be followed by bytes_release before the next peek/recv.
+-----------------------------------------------------------------------------*/
+int bytes_peek(ReceiverBytes *receiver, void **data, size_t *len);
+
+/*-----------------------------------------------------------------------------
+  bytes_release
+  Frees the record exposed by the last bytes_peek.
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver is NULL or nothing is peeked
+-----------------------------------------------------------------------------*/
+int bytes_release(ReceiverBytes *receiver);
+
+/*-----------------------------------------------------------------------------
+  bytes_recv
+  Copies the oldest committed record into `out`.
+
+  receiver : pointer to a valid ReceiverBytes
+  out      : destination buffer
+  cap      : size of out in bytes
+  len      : receives the payload size
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if an argument is NULL
+    - CHANNEL_ERR_FULL    if out is too small (*len is set, record is kept)
+    - CHANNEL_ERR_EMPTY   if the next record is not committed yet
+    - CHANNEL_ERR_CLOSED  if channel is closed and drained
+-----------------------------------------------------------------------------*/
+int bytes_recv(ReceiverBytes *receiver, void *out, size_t cap, size_t *len);
+
+#endif
+
+#if (defined(BYTES_IMPLEMENTATION))
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define BYTES_HEADER_SIZE 8
+#define BYTES_COMMITTED ((uint64_t)1 << 63)
+
+typedef struct ChannelBytes_t {
+  uint8_t *buffer;  // 2 * capacity bytes of address space, mirrored
+  size_t capacity;  // bytes, power of two
+  ProducerCursor producer;
+  ConsumerCursor consumer;
+
+  _Atomic size_t prod_cont; // Number of active producers
+  _Atomic ChanState state;  // 0 -> Open | 1 -> Closed
+  _Atomic(ChannelSignal *) signal; // optional, see bytes_set_signal
+} ChannelBytes;
+
+typedef struct SenderBytes_t {
+  uint8_t *buffer;
+  size_t mask;
+
+  _Atomic size_t *head;
+  _Atomic size_t *tail;
+  _Atomic size_t *chan_prod_count;
+  _Atomic ChanState *chan_state;
+  _Atomic ChanState sender_state;
+  _Atomic(ChannelSignal *) *signal;
+
+  size_t tail_cache; // last observed consumer tail
+
+  uint64_t *reserved; // header of the pending reservation, NULL if none
+  size_t reserved_len;
+} SenderBytes;
+
+typedef struct ReceiverBytes_t {
+  uint8_t *buffer;
+  size_t mask;
+
+  _Atomic size_t *head;
+  _Atomic size_t *tail;
+  _Atomic ChanState *chan_state;
+
+  size_t tail_local; // consumer owns tail, no need to read it back
+  size_t peeked;     // size of the peeked record, 0 if none
+} ReceiverBytes;
+
+static inline size_t _bytes_record_size(size_t len) {
+  return (BYTES_HEADER_SIZE + len + 7) & ~(size_t)7;
+}
+
+static inline _Atomic uint64_t *_bytes_header(uint8_t *buffer, size_t mask,
+                                              size_t pos) {
+  return (_Atomic uint64_t *)(buffer + (pos & mask));
+}
+
+ChannelBytes *channel_create_bytes(const size_t capacity) {
+  long page = sysconf(_SC_PAGESIZE);
+  size_t cap = page > 0 ? (size_t)page : 4096;
+  while (cap < capacity) {
+    cap <<= 1;
+  }
+
+  ChannelBytes *chan = malloc(sizeof(ChannelBytes));
+  if (!chan) {
+    return NULL;
+  }
+
+  int fd = (int)syscall(SYS_memfd_create, "seakcutils_bytes", 0);
+  if (fd < 0) {
+    free(chan);
+    return NULL;
+  }
+  if (ftruncate(fd, (off_t)cap) != 0) {
+    close(fd);
+    free(chan);
+    return NULL;
+  }
+
+  // reserve 2 * cap of address space, then map the file over both halves
+  uint8_t *base = mmap(NULL, 2 * cap, PROT_NONE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    close(fd);
+    free(chan);
+    return NULL;
+  }
+  if (mmap(base, cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd,
+           0) == MAP_FAILED ||
+      mmap(base + cap, cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+           fd, 0) == MAP_FAILED) {
+    munmap(base, 2 * cap);
+    close(fd);
+    free(chan);
+    return NULL;
+  }
+  close(fd); // the mappings keep the memory alive
+
+  chan->buffer = base; // memfd pages start zeroed
+  chan->capacity = cap;
+  chan->producer.head = 0;
+  chan->consumer.tail = 0;
+  chan->prod_cont = 0;
+  chan->state = OPEN;
+  chan->signal = NULL;
+  return chan;
+}
+
+void bytes_close(ChannelBytes *chan) {
+  atomic_store_explicit(&chan->state, CLOSED, memory_order_release);
+  _channel_signal_poke(&chan->signal);
+}
+
+ChanState bytes_is_closed(const ChannelBytes *chan) {
+  return atomic_load_explicit(&chan->state, memory_order_acquire);
+}
+
+void bytes_set_signal(ChannelBytes *chan, ChannelSignal *sig) {
+  atomic_store_explicit(&chan->signal, sig, memory_order_release);
+}
+
+void bytes_destroy(ChannelBytes *chan) {
+  if (!chan) {
+    return;
+  }
+
+  bytes_close(chan);
+  while (atomic_load_explicit(&chan->prod_cont, memory_order_acquire) != 0) {
+    cpu_relax();
+  }
+
+  munmap(chan->buffer, 2 * chan->capacity);
+  free(chan);
+}
+
+SenderBytes *bytes_get_sender(ChannelBytes *chan) {
+  if (!chan) {
+    return NULL;
+  }
+  SenderBytes *sender = malloc(sizeof(SenderBytes));
+  if (!sender) {
+    return NULL;
+  }
+
+  sender->buffer = chan->buffer;
+  sender->mask = chan->capacity - 1;
+  sender->head = &chan->producer.head;
+  sender->tail = &chan->consumer.tail;
+  sender->chan_state = &chan->state;
+  sender->sender_state = OPEN;
+  sender->signal = &chan->signal;
+  sender->tail_cache =
+      atomic_load_explicit(&chan->consumer.tail, memory_order_acquire);
+  sender->reserved = NULL;
+  sender->reserved_len = 0;
+
+  atomic_fetch_add_explicit(&chan->prod_cont, 1, memory_order_release);
+  sender->chan_prod_count = &chan->prod_cont;
+  return sender;
+}
+
+ReceiverBytes *bytes_get_receiver(ChannelBytes *chan) {
+  if (!chan) {
+    return NULL;
+  }
+  ReceiverBytes *receiver = malloc(sizeof(ReceiverBytes));
+  if (!receiver) {
+    return NULL;
+  }
+
+  receiver->buffer = chan->buffer;
+  receiver->mask = chan->capacity - 1;
+  receiver->head = &chan->producer.head;
+  receiver->tail = &chan->consumer.tail;
+  receiver->chan_state = &chan->state;
+  receiver->tail_local =
+      atomic_load_explicit(&chan->consumer.tail, memory_order_relaxed);
+  receiver->peeked = 0;
+  return receiver;
+}
+
+void bytes_close_sender(SenderBytes *sender) {
+  atomic_fetch_sub_explicit(sender->chan_prod_count, 1, memory_order_release);
+  atomic_store_explicit(&sender->sender_state, CLOSED, memory_order_release);
+}
+
+int bytes_reserve(SenderBytes *sender, size_t len, void **data) {
+  if (!sender || !data) {
+    return CHANNEL_ERR_NULL;
+  }
+  size_t size = _bytes_record_size(len);
+  if (size > sender->mask + 1) {
+    return CHANNEL_ERR_NULL; // can never fit
+  }
+  if (sender->reserved) {
+    return CHANNEL_ERR_FULL;
+  }
+  if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+      CLOSED) {
+    return CHANNEL_ERR_CLOSED;
+  }
+
+  size_t head = atomic_load_explicit(sender->head, memory_order_relaxed);
+  for (;;) {
+    if (head + size - sender->tail_cache > sender->mask + 1) {
+      // looks full: refresh the consumer position once
+      sender->tail_cache =
+          atomic_load_explicit(sender->tail, memory_order_acquire);
+      if (head + size - sender->tail_cache > sender->mask + 1) {
+        return CHANNEL_ERR_FULL;
+      }
+    }
+    if (atomic_compare_exchange_weak_explicit(sender->head, &head, head + size,
+                                              memory_order_relaxed,
+                                              memory_order_relaxed)) {
+      break;
+    }
+    cpu_relax();
+  }
+
+  // the region is zeroed and contiguous (mirrored mapping)
+  sender->reserved = (uint64_t *)_bytes_header(sender->buffer, sender->mask,
+                                               head);
+  sender->reserved_len = len;
+  *data = (uint8_t *)sender->reserved + BYTES_HEADER_SIZE;
+  return CHANNEL_OK;
+}
+
+int bytes_commit(SenderBytes *sender) {
+  if (!sender || !sender->reserved) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  // publish payload and length together
+  atomic_store_explicit((_Atomic uint64_t *)sender->reserved,
+                        (uint64_t)sender->reserved_len | BYTES_COMMITTED,
+                        memory_order_release);
+  sender->reserved = NULL;
+  _channel_signal_poke(sender->signal);
+  return CHANNEL_OK;
+}
+
+int bytes_send(SenderBytes *sender, const void *data, size_t len) {
+  void *dst;
+  int res = bytes_reserve(sender, len, &dst);
+  if (res != CHANNEL_OK) {
+    return res;
+  }
+  memcpy(dst, data, len);
+  return bytes_commit(sender);
+}
+
+int bytes_peek(ReceiverBytes *receiver, void **data, size_t *len) {
+  if (!receiver || !data || !len) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  _Atomic uint64_t *hdr =
+      _bytes_header(receiver->buffer, receiver->mask, receiver->tail_local);
+  uint64_t value = atomic_load_explicit(hdr, memory_order_acquire);
+
+  if (!(value & BYTES_COMMITTED)) {
+    if (atomic_load_explicit(receiver->chan_state, memory_order_acquire) ==
+            CLOSED &&
+        atomic_load_explicit(receiver->head, memory_order_acquire) ==
+            receiver->tail_local) {
+      return CHANNEL_ERR_CLOSED; // closed and drained
+    }
+    return CHANNEL_ERR_EMPTY;
+  }
+
+  *len = (size_t)(value & ~BYTES_COMMITTED);
+  *data = (uint8_t *)hdr + BYTES_HEADER_SIZE;
+  receiver->peeked = _bytes_record_size(*len);
+  return CHANNEL_OK;
+}
+
+int bytes_release(ReceiverBytes *receiver) {
+  if (!receiver || !receiver->peeked) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  // hand the region back zeroed, producers rely on it
+  memset(receiver->buffer + (receiver->tail_local & receiver->mask), 0,
+         receiver->peeked);
+  receiver->tail_local += receiver->peeked;
+  receiver->peeked = 0;
+  atomic_store_explicit(receiver->tail, receiver->tail_local,
+                        memory_order_release);
+  return CHANNEL_OK;
+}
+
+int bytes_recv(ReceiverBytes *receiver, void *out, size_t cap, size_t *len) {
+  if (!out) {
+    return CHANNEL_ERR_NULL;
+  }
+  void *data;
+  int res = bytes_peek(receiver, &data, len);
+  if (res != CHANNEL_OK) {
+    return res;
+  }
+  if (*len > cap) {
+    receiver->peeked = 0;
+    return CHANNEL_ERR_FULL;
+  }
+  memcpy(out, data, *len);
+  return bytes_release(receiver);
+}
+#endif
@@ -31,6 +31,7 @@ Instead, it provides:
 - cache-line aligned cursor structures
 - slot metadata
 - platform-specific cpu_relax()
+- ChannelSignal, a readiness word producers bump after publishing
 
 All channel implementations depend on this header.
 
@@ -92,6 +93,38 @@ The instruction varies by architecture:
 - RISC-V    → PAUSE
 - Fallback  → no-op
 
+------------------------------------------------------------------------------
+CHANNEL SIGNAL
+
+A ChannelSignal is a 32-bit sequence that producers increment after every
+publish (and on close) once it is attached to a channel with
+X_set_signal(). Several channels can share one signal, which lets a
+consumer sleep until ANY of them has data (see select.h) instead of
+polling each one.
+
+Waiting is a futex on Linux, a yield loop elsewhere. Producers only make
+the wake syscall when someone is actually sleeping.
+
+------------------------------------------------------------------------------
+TELEMETRY
+
+Compile with -DCHANNEL_TELEMETRY to make SPSC, MPSC, SPMC and MPMC
+channels count, per channel:
+
+    sends, recvs        successful operations
+    full_spins          wait iterations (or failed attempts) on a full ring
+    empty_spins         wait iterations (or failed attempts) on an empty ring
+    closed_errors       operations that returned CHANNEL_ERR_CLOSED
+    high_water          highest occupancy seen by a sender
+
+Counters live in CHANNEL_TELEMETRY_SHARDS cache-line sized shards; each
+sender/receiver is bound to one shard when it is created, so handles on
+different threads never write the same line. X_stats() sums the shards
+into a ChannelStats snapshot.
+
+Without CHANNEL_TELEMETRY the counting compiles to nothing and X_stats()
+returns CHANNEL_ERR_NULL.
+
 ------------------------------------------------------------------------------
 USAGE
 
@@ -110,6 +143,7 @@ In exactly ONE source file:
 #define CHANNELS_H
 
 #include <stdalign.h>
+#include <stdatomic.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -143,6 +177,71 @@ typedef struct ProducerCursor_t ProducerCursor;
 // - sequence number for synchronization
 typedef struct Slot_t Slot;
 
+// Readiness word shared between producers and a waiting consumer.
+// seq     : bumped by producers after each publish
+// waiters : number of threads sleeping on seq
+typedef struct ChannelSignal_t {
+  alignas(CACHELINE_SIZE) _Atomic uint32_t seq;
+  _Atomic uint32_t waiters;
+} ChannelSignal;
+
+/*-----------------------------------------------------------------------------
+  channel_signal_init
+  Resets a signal. Must be called before attaching it to a channel.
+-----------------------------------------------------------------------------*/
+void channel_signal_init(ChannelSignal *sig);
+
+/*-----------------------------------------------------------------------------
+  channel_signal_notify
+  Bumps the sequence and wakes every waiter, if any.
+
+  Notes:
+    - Called by the channels themselves after a publish, only needed by
+      hand for custom wake-ups (e.g. a shutdown request).
+-----------------------------------------------------------------------------*/
+void channel_signal_notify(ChannelSignal *sig);
+
+/*-----------------------------------------------------------------------------
+  channel_signal_notify_n
+  Bumps the sequence and wakes at most `n` waiters.
+
+  Notes:
+    - Used by pools that park idle workers on one signal, so a single
+      submission does not wake every sleeper.
+-----------------------------------------------------------------------------*/
+void channel_signal_notify_n(ChannelSignal *sig, uint32_t n);
+
+/*-----------------------------------------------------------------------------
+  channel_signal_wait
+  Sleeps while the sequence still equals `seen`.
+
+  sig        : signal to wait on
+  seen       : value of sig->seq read BEFORE checking the channels
+  timeout_ns : maximum time to sleep, negative waits forever
+
+  Returns:
+    - CHANNEL_OK        woken up, or the sequence already moved
+    - CHANNEL_ERR_EMPTY timed out
+
+  Notes:
+    - Spurious wake-ups are possible, re-check the channels after.
+-----------------------------------------------------------------------------*/
+int channel_signal_wait(ChannelSignal *sig, uint32_t seen, int64_t timeout_ns);
+
+#ifndef CHANNEL_TELEMETRY_SHARDS
+#define CHANNEL_TELEMETRY_SHARDS 16
+#endif
+
+// Snapshot of a channel's telemetry counters (see X_stats).
+typedef struct ChannelStats_t {
+  uint64_t sends;
+  uint64_t recvs;
+  uint64_t full_spins;
+  uint64_t empty_spins;
+  uint64_t closed_errors;
+  uint64_t high_water;
+} ChannelStats;
+
 /*-------------------------------------------*/
 /*      Platform-dependent cpu_relax()       */
 /*-------------------------------------------*/
@@ -183,4 +282,166 @@ typedef struct Slot_t {
   _Atomic size_t seq;
 } Slot;
 
+#if defined(__linux__)
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <sched.h>
+#endif
+#include <time.h>
+
+void channel_signal_init(ChannelSignal *sig) {
+  atomic_init(&sig->seq, 0);
+  atomic_init(&sig->waiters, 0);
+}
+
+void channel_signal_notify(ChannelSignal *sig) {
+  channel_signal_notify_n(sig, INT32_MAX);
+}
+
+void channel_signal_notify_n(ChannelSignal *sig, uint32_t n) {
+  atomic_fetch_add_explicit(&sig->seq, 1, memory_order_seq_cst);
+  if (n == 0 ||
+      atomic_load_explicit(&sig->waiters, memory_order_seq_cst) == 0) {
+    return;
+  }
+#if defined(__linux__)
+  syscall(SYS_futex, &sig->seq, FUTEX_WAKE_PRIVATE,
+          n > INT32_MAX ? INT32_MAX : (int)n, NULL, NULL, 0);
+#endif
+}
+
+int channel_signal_wait(ChannelSignal *sig, uint32_t seen, int64_t timeout_ns) {
+  int res = CHANNEL_OK;
+
+  // a notifier that misses this increment has already moved seq, the
+  // kernel re-checks it before sleeping
+  atomic_fetch_add_explicit(&sig->waiters, 1, memory_order_seq_cst);
+#if defined(__linux__)
+  struct timespec ts;
+  struct timespec *tsp = NULL;
+  if (timeout_ns >= 0) {
+    ts.tv_sec = timeout_ns / 1000000000;
+    ts.tv_nsec = timeout_ns % 1000000000;
+    tsp = &ts;
+  }
+  if (syscall(SYS_futex, &sig->seq, FUTEX_WAIT_PRIVATE, seen, tsp, NULL, 0) ==
+          -1 &&
+      errno == ETIMEDOUT) {
+    res = CHANNEL_ERR_EMPTY;
+  }
+#else
+  struct timespec start, now;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  while (atomic_load_explicit(&sig->seq, memory_order_seq_cst) == seen) {
+    if (timeout_ns >= 0) {
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      int64_t elapsed = (int64_t)(now.tv_sec - start.tv_sec) * 1000000000 +
+                        (now.tv_nsec - start.tv_nsec);
+      if (elapsed >= timeout_ns) {
+        res = CHANNEL_ERR_EMPTY;
+        break;
+      }
+    }
+    sched_yield();
+  }
+#endif
+  atomic_fetch_sub_explicit(&sig->waiters, 1, memory_order_relaxed);
+  return res;
+}
+
+#if defined(CHANNEL_TELEMETRY)
+// One cache line of counters, written by the handles bound to it.
+typedef struct ChannelStatsShard_t {
+  alignas(CACHELINE_SIZE) _Atomic uint64_t sends;
+  _Atomic uint64_t recvs;
+  _Atomic uint64_t full_spins;
+  _Atomic uint64_t empty_spins;
+  _Atomic uint64_t closed_errors;
+  _Atomic uint64_t high_water;
+} ChannelStatsShard;
+
+typedef struct ChannelTelemetry_t {
+  ChannelStatsShard shards[CHANNEL_TELEMETRY_SHARDS];
+  _Atomic size_t next_shard;
+} ChannelTelemetry;
+
+#define CHANNEL_STAT_ADD(shard, field, n)                                      \
+  atomic_fetch_add_explicit(&(shard)->field, (uint64_t)(n),                    \
+                            memory_order_relaxed)
+#define CHANNEL_STAT_MAX(shard, value) _channel_stat_max((shard), (value))
+
+static inline void _channel_telemetry_init(ChannelTelemetry *tel) {
+  for (size_t x = 0; x < CHANNEL_TELEMETRY_SHARDS; x++) {
+    ChannelStatsShard *shard = &tel->shards[x];
+    atomic_init(&shard->sends, 0);
+    atomic_init(&shard->recvs, 0);
+    atomic_init(&shard->full_spins, 0);
+    atomic_init(&shard->empty_spins, 0);
+    atomic_init(&shard->closed_errors, 0);
+    atomic_init(&shard->high_water, 0);
+  }
+  atomic_init(&tel->next_shard, 0);
+}
+
+// Binds a new handle to a shard, round-robin.
+static inline ChannelStatsShard *
+_channel_telemetry_shard(ChannelTelemetry *tel) {
+  size_t x = atomic_fetch_add_explicit(&tel->next_shard, 1,
+                                       memory_order_relaxed);
+  return &tel->shards[x % CHANNEL_TELEMETRY_SHARDS];
+}
+
+static inline void _channel_stat_max(ChannelStatsShard *shard,
+                                     uint64_t value) {
+  uint64_t cur = atomic_load_explicit(&shard->high_water, memory_order_relaxed);
+  while (value > cur &&
+         !atomic_compare_exchange_weak_explicit(&shard->high_water, &cur, value,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed)) {
+  }
+}
+
+// Elements in flight between a producer position and the consumer cursor
+// (the cursor may run ahead when blocking receivers already claimed).
+static inline uint64_t _channel_occupancy(size_t head, size_t tail) {
+  return head > tail ? (uint64_t)(head - tail) : 0;
+}
+
+static inline void
+_channel_telemetry_snapshot(const ChannelTelemetry *tel, ChannelStats *out) {
+  ChannelStats stats = {0};
+  for (size_t x = 0; x < CHANNEL_TELEMETRY_SHARDS; x++) {
+    ChannelStatsShard *shard = (ChannelStatsShard *)&tel->shards[x];
+    stats.sends += atomic_load_explicit(&shard->sends, memory_order_relaxed);
+    stats.recvs += atomic_load_explicit(&shard->recvs, memory_order_relaxed);
+    stats.full_spins +=
+        atomic_load_explicit(&shard->full_spins, memory_order_relaxed);
+    stats.empty_spins +=
+        atomic_load_explicit(&shard->empty_spins, memory_order_relaxed);
+    stats.closed_errors +=
+        atomic_load_explicit(&shard->closed_errors, memory_order_relaxed);
+    uint64_t hw = atomic_load_explicit(&shard->high_water, memory_order_relaxed);
+    if (hw > stats.high_water) {
+      stats.high_water = hw;
+    }
+  }
+  *out = stats;
+}
+#else
+// counting compiles out; `n` is still evaluated so spin counters stay used
+#define CHANNEL_STAT_ADD(shard, field, n) ((void)(n))
+#define CHANNEL_STAT_MAX(shard, value) ((void)0)
+#endif
+
+// Notifies the signal attached to a channel, if any.
+static inline void _channel_signal_poke(_Atomic(ChannelSignal *) *signal) {
+  ChannelSignal *sig = atomic_load_explicit(signal, memory_order_acquire);
+  if (sig) {
+    channel_signal_notify(sig);
+  }
+}
+
 #endif // !CHANNELS_H
@@ -0,0 +1,744 @@
+// Copyright 2025 Seaker <seakerone@proton.me>
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+------------------------------------------------------------------------------
+mcast.h — Multicast (disruptor-style) lock-free ring channel
+
+This channel supports:
+- one or more producers
+- any number of consumers, each of them seeing EVERY element
+- consumers chained in dependency order (B reads an element only after A)
+- fixed-capacity ring buffer
+- busy-wait synchronization (no blocking, no syscalls)
+
+SPMC/MPMC consumers compete for elements: each element goes to one of them.
+Here every receiver owns its own sequence (cursor) and walks the whole ring.
+Producers gate on the slowest receiver, so nothing is overwritten before
+every receiver has seen it. Elements live once in the ring, there is no
+per-consumer copy.
+
+------------------------------------------------------------------------------
+PROPERTIES
+
+- Lock-free for producers and consumers
+- No dynamic allocation during send/recv
+- Receivers only write their own cache-line aligned cursor
+- Producers cache the slowest cursor and rescan only when the ring looks full
+- Cross-platform (x86, ARM, RISC-V)
+
+------------------------------------------------------------------------------
+DEPENDENCIES
+
+    ReceiverMcast *input    = mcast_get_receiver(chan, NULL, 0);
+    ReceiverMcast *gameplay = mcast_get_receiver(chan, &input, 1);
+    ReceiverMcast *recorder = mcast_get_receiver(chan, &input, 1);
+
+`gameplay` and `recorder` each read element N only after `input` is done
+with it (its cursor moved past N). They run in parallel with each other.
+
+------------------------------------------------------------------------------
+LIFETIME
+
+1. channel_create_mcast()
+2. mcast_get_receiver() (up to max_receivers times, upstream first)
+3. mcast_get_sender() (N times)
+4. mcast_send() / mcast_recv()
+5. mcast_close()
+6. mcast_close_sender() / mcast_close_receiver()
+7. mcast_destroy()
+
+Attach receivers before producers start: a receiver attached later starts
+at the current producer position and never sees older elements.
+
+Senders and receivers must be freed by the user.
+
+------------------------------------------------------------------------------
+WARNING
+
+This channel uses busy-waiting.
+One stalled receiver stalls every producer once the ring is full.
+------------------------------------------------------------------------------
+*/
+#ifndef MCAST_CHANNEL_H
+#define MCAST_CHANNEL_H
+
+/*-------------------------------------------*/
+/*      Platform-dependent cpu_relax()       */
+/*-------------------------------------------*/
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+#define cpu_relax() _mm_pause()
+/*-------------------------------------------*/
+#elif defined(__aarch64__) || defined(__arm__)
+
+#define cpu_relax() __asm__ __volatile__("yield")
+/*-------------------------------------------*/
+#elif defined(__riscv)
+
+#define cpu_relax() __asm__ __volatile__("pause")
+/*-------------------------------------------*/
+#else
+#define cpu_relax() ((void)0)
+#endif
+/*-------------------------------------------*/
+
+#include <stddef.h>
+
+typedef struct ChannelMcast_t ChannelMcast;
+typedef enum ChanState_t ChanState;
+
+/*-----------------------------------------------------------------------------
+  channel_create_mcast
+  Allocates and initializes a new multicast channel.
+
+  capacity      : number of slots in the ring buffer
+  elem_size     : size in bytes of each element
+  max_receivers : maximum number of receivers that can be attached
+
+  Returns a pointer to ChannelMcast on success, NULL on allocation failure.
+
+  Notes:
+    - All element storage is allocated up front in a single block.
+-----------------------------------------------------------------------------*/
+ChannelMcast *channel_create_mcast(const size_t capacity,
+                                   const size_t elem_size,
+                                   const size_t max_receivers);
+
+/*-----------------------------------------------------------------------------
+  mcast_close
+  Marks the channel as closed.
+
+  chan : pointer to the channel to close
+
+  Notes:
+    - After closing, mcast_send will return CHANNEL_ERR_CLOSED.
+    - Receivers may continue to drain what was published.
+-----------------------------------------------------------------------------*/
+void mcast_close(ChannelMcast *chan);
+
+/*-----------------------------------------------------------------------------
+  mcast_is_closed
+  Checks whether the channel has been closed.
+
+  chan : pointer to the channel
+
+  Returns:
+    - OPEN   if the channel is still open
+    - CLOSED if the channel has been closed
+-----------------------------------------------------------------------------*/
+ChanState mcast_is_closed(const ChannelMcast *chan);
+
+/*-----------------------------------------------------------------------------
+  mcast_set_signal
+  Attaches a ChannelSignal that senders bump after each publish and on close.
+
+  chan : pointer to the channel
+  sig  : signal to attach, NULL to detach
+
+  Notes:
+    - Several channels may share one signal (see select.h).
+    - Attach before handing out senders or while they are idle.
+-----------------------------------------------------------------------------*/
+void mcast_set_signal(ChannelMcast *chan, ChannelSignal *sig);
+
+/*-----------------------------------------------------------------------------
+  mcast_destroy
+  Frees all memory associated with the channel.
+
+  chan : pointer to the channel
+
+  Notes:
+    - Blocks until all senders and receivers are closed.
+    - After this call, the channel pointer becomes invalid.
+-----------------------------------------------------------------------------*/
+void mcast_destroy(ChannelMcast *chan);
+
+typedef struct SenderMcast_t SenderMcast;
+typedef struct ReceiverMcast_t ReceiverMcast;
+
+/*-----------------------------------------------------------------------------
+  mcast_get_sender
+  Allocates and returns a producer handle for the given channel.
+
+  chan : pointer to a valid ChannelMcast
+
+  Returns a pointer to SenderMcast on success, NULL on failure.
+
+  Notes:
+    - Multiple senders can be attached concurrently.
+    - Each sender must call mcast_close_sender before freeing.
+-----------------------------------------------------------------------------*/
+SenderMcast *mcast_get_sender(ChannelMcast *chan);
+
+/*-----------------------------------------------------------------------------
+  mcast_get_receiver
+  Allocates and returns a consumer handle with its own sequence.
+
+  chan      : pointer to a valid ChannelMcast
+  after     : receivers that must process an element before this one
+              (NULL if none)
+  num_after : number of entries in `after`
+
+  Returns a pointer to ReceiverMcast on success, NULL on failure or if
+  max_receivers are already attached.
+
+  Notes:
+    - Every receiver sees every element published after it was attached.
+    - Each receiver must call mcast_close_receiver before freeing.
+    - A receiver handle must only be used by one thread.
+-----------------------------------------------------------------------------*/
+ReceiverMcast *mcast_get_receiver(ChannelMcast *chan, ReceiverMcast **after,
+                                  size_t num_after);
+
+/*-----------------------------------------------------------------------------
+  mcast_close_sender
+  Marks a sender as closed and decrements the channel's producer count.
+
+  sender : pointer to a valid SenderMcast
+-----------------------------------------------------------------------------*/
+void mcast_close_sender(SenderMcast *sender);
+
+/*-----------------------------------------------------------------------------
+  mcast_close_receiver
+  Detaches a receiver: producers stop gating on it and receivers chained
+  after it stop waiting for it.
+
+  receiver : pointer to a valid ReceiverMcast
+-----------------------------------------------------------------------------*/
+void mcast_close_receiver(ReceiverMcast *receiver);
+
+/*-----------------------------------------------------------------------------
+  mcast_send
+  Publishes an element to every receiver.
+
+  sender  : pointer to a valid SenderMcast
+  element : pointer to the element data to send
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if sender is NULL
+    - CHANNEL_ERR_CLOSED  if channel is closed
+
+  Notes:
+    - Busy-waits while the slowest receiver is a full ring behind.
+    - Copies elem_size bytes from element to the internal buffer.
+-----------------------------------------------------------------------------*/
+int mcast_send(SenderMcast *sender, const void *element);
+
+/*-----------------------------------------------------------------------------
+  mcast_reserve / mcast_commit
+  Zero-copy send: claim the next slot, write it in place, publish it.
+
+  Returns the same codes as mcast_send, mcast_reserve also returns
+  CHANNEL_ERR_FULL if the sender already holds a reservation.
+-----------------------------------------------------------------------------*/
+int mcast_reserve(SenderMcast *sender, void **slot);
+int mcast_commit(SenderMcast *sender);
+
+/*-----------------------------------------------------------------------------
+  mcast_recv
+  Copies the next element of this receiver's sequence into `out`.
+
+  receiver : pointer to a valid ReceiverMcast
+  out      : pointer to memory where the element will be copied
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver is NULL
+    - CHANNEL_ERR_CLOSED  if receiver is closed, or the channel is closed
+                          and nothing is left for this receiver
+    - CHANNEL_ERR_EMPTY   if a mcast_peek slot is pending (release it first)
+
+  Notes:
+    - Busy-waits until the element is published and every upstream
+      receiver is done with it.
+    - After close, elements published before it are still delivered, once
+      upstream receivers pass them (or detach).
+-----------------------------------------------------------------------------*/
+int mcast_recv(ReceiverMcast *receiver, void *out);
+
+/*-----------------------------------------------------------------------------
+  mcast_try_recv
+  Non-blocking mcast_recv, returns CHANNEL_ERR_EMPTY if the next element is
+  not available yet (also after close, while an upstream receiver still
+  holds a published element).
+-----------------------------------------------------------------------------*/
+int mcast_try_recv(ReceiverMcast *receiver, void *out);
+
+/*-----------------------------------------------------------------------------
+  mcast_peek / mcast_release
+  Zero-copy receive: read the next element in place, then release it.
+
+  Notes:
+    - mcast_peek waits like mcast_recv.
+    - mcast_peek returns CHANNEL_ERR_FULL while a peek is pending.
+    - Other receivers read the same slot concurrently: treat it as read-only,
+      unless every receiver reading it is chained after this one.
+-----------------------------------------------------------------------------*/
+int mcast_peek(ReceiverMcast *receiver, void **slot);
+int mcast_release(ReceiverMcast *receiver);
+
+#endif
+
+#if (defined(MCAST_IMPLEMENTATION))
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// cursor value of a detached receiver, ignored by gating
+#define MCAST_CURSOR_DETACHED SIZE_MAX
+
+typedef struct ChannelMcast_t {
+  Slot *buffer;      // slot.seq == pos + 1 once position `pos` is published
+  uint8_t *storage;  // element storage backing buffer[i].data
+  size_t capacity;   // number of elements
+  size_t elem_size;  // sizeof(T)
+  ProducerCursor producer;
+
+  ConsumerCursor *cursors; // one per receiver: next position it will read
+  size_t max_receivers;
+  _Atomic size_t num_receivers;
+
+  _Atomic size_t cons_cont; // Number of active consumers
+  _Atomic size_t prod_cont; // Number of active producers
+  _Atomic ChanState state;  // 0 -> Open | 1 -> Closed
+  _Atomic(ChannelSignal *) signal; // optional, see mcast_set_signal
+} ChannelMcast;
+
+ChannelMcast *channel_create_mcast(const size_t capacity,
+                                   const size_t elem_size,
+                                   const size_t max_receivers) {
+  if (capacity == 0 || max_receivers == 0) {
+    return NULL;
+  }
+  ChannelMcast *chan = malloc(sizeof(ChannelMcast));
+  if (!chan) {
+    return NULL;
+  }
+
+  chan->buffer = aligned_alloc(CACHELINE_SIZE, capacity * sizeof(Slot));
+  chan->storage = malloc(capacity * elem_size);
+  chan->cursors =
+      aligned_alloc(CACHELINE_SIZE, max_receivers * sizeof(ConsumerCursor));
+  if (!chan->buffer || !chan->storage || !chan->cursors) {
+    free(chan->buffer);
+    free(chan->storage);
+    free(chan->cursors);
+    free(chan);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < capacity; i++) {
+    atomic_init(&chan->buffer[i].seq, 0);
+    chan->buffer[i].data = chan->storage + (i * elem_size);
+  }
+  for (size_t i = 0; i < max_receivers; i++) {
+    atomic_init(&chan->cursors[i].tail, MCAST_CURSOR_DETACHED);
+  }
+
+  chan->capacity = capacity;
+  chan->elem_size = elem_size;
+  chan->max_receivers = max_receivers;
+  atomic_init(&chan->producer.head, 0);
+  atomic_init(&chan->num_receivers, 0);
+  atomic_init(&chan->cons_cont, 0);
+  atomic_init(&chan->prod_cont, 0);
+  atomic_init(&chan->state, OPEN);
+  atomic_init(&chan->signal, NULL);
+
+  return chan;
+}
+
+void mcast_close(ChannelMcast *chan) {
+  atomic_store_explicit(&chan->state, CLOSED, memory_order_release);
+  _channel_signal_poke(&chan->signal);
+}
+
+ChanState mcast_is_closed(const ChannelMcast *chan) {
+  return atomic_load_explicit(&chan->state, memory_order_acquire);
+}
+
+void mcast_set_signal(ChannelMcast *chan, ChannelSignal *sig) {
+  atomic_store_explicit(&chan->signal, sig, memory_order_release);
+}
+
+void mcast_destroy(ChannelMcast *chan) {
+  if (!chan) {
+    return;
+  }
+
+  size_t cons_cont;
+  size_t prod_cont;
+
+  mcast_close(chan);
+  do {
+    cons_cont = atomic_load_explicit(&chan->cons_cont, memory_order_acquire);
+    prod_cont = atomic_load_explicit(&chan->prod_cont, memory_order_acquire);
+  } while (cons_cont != 0 || prod_cont != 0);
+
+  free(chan->cursors);
+  free(chan->storage);
+  free(chan->buffer);
+  free(chan);
+}
+
+typedef struct SenderMcast_t {
+  Slot *buffer;
+  size_t inner_c_cap;
+  size_t elem_size;
+
+  _Atomic size_t *head;
+  ConsumerCursor *cursors;
+  _Atomic size_t *num_receivers;
+  size_t gate; // cached slowest receiver position
+
+  _Atomic ChanState sender_state;
+  _Atomic ChanState *chan_state;
+  _Atomic size_t *chan_prod_count;
+
+  Slot *reserved; // slot claimed by mcast_reserve, NULL if none
+  size_t reserved_pos;
+
+  _Atomic(ChannelSignal *) *signal;
+} SenderMcast;
+
+typedef struct ReceiverMcast_t {
+  Slot *buffer;
+  size_t inner_c_cap;
+  size_t elem_size;
+
+  _Atomic size_t *cursor; // this receiver's sequence, shared with producers
+  size_t next;            // local copy of *cursor
+  _Atomic size_t **after; // cursors of upstream receivers
+  size_t num_after;
+  size_t upstream; // cached slowest upstream position
+
+  _Atomic ChanState receiver_state;
+  _Atomic ChanState *chan_state;
+  _Atomic size_t *chan_cons_count;
+
+  uint8_t peeked; // 1 while a mcast_peek slot is pending
+} ReceiverMcast;
+
+SenderMcast *mcast_get_sender(ChannelMcast *chan) {
+  if (!chan) {
+    return NULL;
+  }
+  SenderMcast *sender = malloc(sizeof(SenderMcast));
+  if (!sender) {
+    return NULL;
+  }
+
+  sender->buffer = chan->buffer;
+  sender->inner_c_cap = chan->capacity;
+  sender->elem_size = chan->elem_size;
+  sender->head = &chan->producer.head;
+  sender->cursors = chan->cursors;
+  sender->num_receivers = &chan->num_receivers;
+  sender->gate = 0;
+  sender->chan_state = &chan->state;
+  sender->signal = &chan->signal;
+  sender->reserved = NULL;
+  sender->reserved_pos = 0;
+  atomic_init(&sender->sender_state, OPEN);
+
+  atomic_fetch_add_explicit(&chan->prod_cont, 1, memory_order_release);
+  sender->chan_prod_count = &chan->prod_cont;
+  return sender;
+}
+
+ReceiverMcast *mcast_get_receiver(ChannelMcast *chan, ReceiverMcast **after,
+                                  size_t num_after) {
+  if (!chan || (num_after > 0 && !after)) {
+    return NULL;
+  }
+  size_t id =
+      atomic_fetch_add_explicit(&chan->num_receivers, 1, memory_order_acq_rel);
+  if (id >= chan->max_receivers) {
+    atomic_fetch_sub_explicit(&chan->num_receivers, 1, memory_order_acq_rel);
+    return NULL;
+  }
+
+  ReceiverMcast *receiver = malloc(sizeof(ReceiverMcast));
+  if (!receiver) {
+    return NULL;
+  }
+  receiver->after = NULL;
+  if (num_after > 0) {
+    receiver->after = malloc(num_after * sizeof(_Atomic size_t *));
+    if (!receiver->after) {
+      free(receiver);
+      return NULL;
+    }
+    for (size_t x = 0; x < num_after; x++) {
+      receiver->after[x] = after[x]->cursor;
+    }
+  }
+
+  receiver->buffer = chan->buffer;
+  receiver->inner_c_cap = chan->capacity;
+  receiver->elem_size = chan->elem_size;
+  receiver->num_after = num_after;
+  receiver->upstream = 0;
+  receiver->cursor = &chan->cursors[id].tail;
+  receiver->next =
+      atomic_load_explicit(&chan->producer.head, memory_order_acquire);
+  receiver->chan_state = &chan->state;
+  receiver->peeked = 0;
+  atomic_init(&receiver->receiver_state, OPEN);
+
+  // until this store the cursor reads as detached and producers skip it
+  atomic_store_explicit(receiver->cursor, receiver->next, memory_order_release);
+
+  atomic_fetch_add_explicit(&chan->cons_cont, 1, memory_order_release);
+  receiver->chan_cons_count = &chan->cons_cont;
+  return receiver;
+}
+
+void mcast_close_sender(SenderMcast *sender) {
+  atomic_fetch_sub_explicit(sender->chan_prod_count, 1, memory_order_release);
+  atomic_store_explicit(&sender->sender_state, CLOSED, memory_order_release);
+}
+
+void mcast_close_receiver(ReceiverMcast *receiver) {
+  atomic_store_explicit(receiver->cursor, MCAST_CURSOR_DETACHED,
+                        memory_order_release);
+  free(receiver->after);
+  receiver->after = NULL;
+  receiver->num_after = 0;
+  atomic_fetch_sub_explicit(receiver->chan_cons_count, 1, memory_order_release);
+  atomic_store_explicit(&receiver->receiver_state, CLOSED,
+                        memory_order_release);
+}
+
+static inline size_t _mcast_slowest(SenderMcast *sender) {
+  size_t n = atomic_load_explicit(sender->num_receivers, memory_order_acquire);
+  size_t slowest = MCAST_CURSOR_DETACHED;
+  for (size_t x = 0; x < n; x++) {
+    size_t pos =
+        atomic_load_explicit(&sender->cursors[x].tail, memory_order_acquire);
+    if (pos < slowest) {
+      slowest = pos;
+    }
+  }
+  return slowest;
+}
+
+static int _mcast_claim(SenderMcast *sender, size_t *pos, Slot **slot) {
+  if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+      CLOSED) {
+    return CHANNEL_ERR_CLOSED;
+  }
+
+  size_t head =
+      atomic_fetch_add_explicit(sender->head, 1, memory_order_acq_rel);
+
+  // position `head` reuses the slot of `head - cap`, every receiver must be
+  // past it. The cached gate is only refreshed when the ring looks full.
+  if (head >= sender->inner_c_cap) {
+    size_t wrap = head - sender->inner_c_cap;
+    while (sender->gate <= wrap) {
+      sender->gate = _mcast_slowest(sender);
+      if (sender->gate > wrap) {
+        break;
+      }
+      if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+          CLOSED) {
+        return CHANNEL_ERR_CLOSED;
+      }
+      cpu_relax();
+    }
+  }
+
+  *pos = head;
+  *slot = &sender->buffer[head % sender->inner_c_cap];
+  return CHANNEL_OK;
+}
+
+int mcast_send(SenderMcast *sender, const void *element) {
+  if (!sender) {
+    return CHANNEL_ERR_NULL;
+  }
+  size_t head;
+  Slot *slot;
+  int res = _mcast_claim(sender, &head, &slot);
+  if (res != CHANNEL_OK) {
+    return res;
+  }
+
+  memcpy(slot->data, element, sender->elem_size);
+
+  // publish position to every receiver
+  atomic_store_explicit(&slot->seq, head + 1, memory_order_release);
+  _channel_signal_poke(sender->signal);
+  return CHANNEL_OK;
+}
+
+int mcast_reserve(SenderMcast *sender, void **slot_out) {
+  if (!sender || !slot_out) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (sender->reserved) {
+    return CHANNEL_ERR_FULL;
+  }
+  size_t head;
+  Slot *slot;
+  int res = _mcast_claim(sender, &head, &slot);
+  if (res != CHANNEL_OK) {
+    return res;
+  }
+
+  sender->reserved = slot;
+  sender->reserved_pos = head;
+  *slot_out = slot->data;
+  return CHANNEL_OK;
+}
+
+int mcast_commit(SenderMcast *sender) {
+  if (!sender || !sender->reserved) {
+    return CHANNEL_ERR_NULL;
+  }
+  atomic_store_explicit(&sender->reserved->seq, sender->reserved_pos + 1,
+                        memory_order_release);
+  _channel_signal_poke(sender->signal);
+  sender->reserved = NULL;
+  return CHANNEL_OK;
+}
+
+// 1 if position `next` is published and every upstream receiver is past it
+static inline int _mcast_available(ReceiverMcast *receiver, Slot *slot) {
+  size_t next = receiver->next;
+  if (atomic_load_explicit(&slot->seq, memory_order_acquire) != next + 1) {
+    return 0;
+  }
+  if (receiver->upstream > next) {
+    return 1;
+  }
+
+  size_t upstream = MCAST_CURSOR_DETACHED;
+  for (size_t x = 0; x < receiver->num_after; x++) {
+    size_t pos = atomic_load_explicit(receiver->after[x], memory_order_acquire);
+    if (pos < upstream) {
+      upstream = pos;
+    }
+  }
+  receiver->upstream = upstream;
+  return upstream > next;
+}
+
+static int _mcast_wait(ReceiverMcast *receiver, Slot **slot_out, int block) {
+  if (atomic_load_explicit(&receiver->receiver_state, memory_order_acquire) ==
+      CLOSED) {
+    return CHANNEL_ERR_CLOSED;
+  }
+  // the next element is the peeked one, mcast_release consumes it
+  if (receiver->peeked) {
+    return CHANNEL_ERR_EMPTY;
+  }
+
+  Slot *slot = &receiver->buffer[receiver->next % receiver->inner_c_cap];
+  while (!_mcast_available(receiver, slot)) {
+    if (atomic_load_explicit(receiver->chan_state, memory_order_acquire) ==
+        CLOSED) {
+      // last look, the element may have been published right before close
+      if (_mcast_available(receiver, slot)) {
+        break;
+      }
+      // published but an upstream receiver hasn't passed it yet: it will,
+      // or it detaches. Only a position never published is the end.
+      if (atomic_load_explicit(&slot->seq, memory_order_acquire) !=
+          receiver->next + 1) {
+        return CHANNEL_ERR_CLOSED;
+      }
+    }
+    if (!block) {
+      return CHANNEL_ERR_EMPTY;
+    }
+    cpu_relax();
+  }
+
+  *slot_out = slot;
+  return CHANNEL_OK;
+}
+
+static inline void _mcast_advance(ReceiverMcast *receiver) {
+  receiver->next++;
+  atomic_store_explicit(receiver->cursor, receiver->next, memory_order_release);
+}
+
+int mcast_recv(ReceiverMcast *receiver, void *out) {
+  if (!receiver) {
+    return CHANNEL_ERR_NULL;
+  }
+  Slot *slot;
+  int res = _mcast_wait(receiver, &slot, 1);
+  if (res != CHANNEL_OK) {
+    return res;
+  }
+  memcpy(out, slot->data, receiver->elem_size);
+  _mcast_advance(receiver);
+  return CHANNEL_OK;
+}
+
+int mcast_try_recv(ReceiverMcast *receiver, void *out) {
+  if (!receiver) {
+    return CHANNEL_ERR_NULL;
+  }
+  Slot *slot;
+  int res = _mcast_wait(receiver, &slot, 0);
+  if (res != CHANNEL_OK) {
+    return res;
+  }
+  memcpy(out, slot->data, receiver->elem_size);
+  _mcast_advance(receiver);
+  return CHANNEL_OK;
+}
+
+int mcast_peek(ReceiverMcast *receiver, void **slot_out) {
+  if (!receiver || !slot_out) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (receiver->peeked) {
+    return CHANNEL_ERR_FULL;
+  }
+  Slot *slot;
+  int res = _mcast_wait(receiver, &slot, 1);
+  if (res != CHANNEL_OK) {
+    return res;
+  }
+  receiver->peeked = 1;
+  *slot_out = slot->data;
+  return CHANNEL_OK;
+}
+
+int mcast_release(ReceiverMcast *receiver) {
+  if (!receiver || !receiver->peeked) {
+    return CHANNEL_ERR_NULL;
+  }
+  receiver->peeked = 0;
+  _mcast_advance(receiver);
+  return CHANNEL_OK;
+}
+#endif
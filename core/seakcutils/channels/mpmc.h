@@ -129,6 +129,47 @@ void mpmc_close(ChannelMpmc *chan);
 -----------------------------------------------------------------------------*/
 ChanState mpmc_is_closed(const ChannelMpmc *chan);
 
+/*-----------------------------------------------------------------------------
+  mpmc_set_signal
+  Attaches a ChannelSignal that senders bump after each publish and on close.
+
+  chan : pointer to the channel
+  sig  : signal to attach, NULL to detach
+
+  Notes:
+    - Several channels may share one signal (see select.h).
+    - Attach before handing out senders or while they are idle.
+-----------------------------------------------------------------------------*/
+void mpmc_set_signal(ChannelMpmc *chan, ChannelSignal *sig);
+
+/*-----------------------------------------------------------------------------
+  mpmc_len
+  Approximate number of queued elements.
+
+  Notes:
+    - Counts reserved positions, so it may include sends still in flight.
+    - Meant for load heuristics (e.g. pool sizing), not for synchronization.
+    - Returns 0 for a NULL channel.
+-----------------------------------------------------------------------------*/
+size_t mpmc_len(const ChannelMpmc *chan);
+
+/*-----------------------------------------------------------------------------
+  mpmc_stats
+  Copies the channel's telemetry counters into `out`.
+
+  chan : pointer to the channel
+  out  : receives the snapshot
+
+  Returns:
+    - CHANNEL_OK        on success
+    - CHANNEL_ERR_NULL  if an argument is NULL or CHANNEL_TELEMETRY is off
+
+  Notes:
+    - Counters are read without stopping the channel, the snapshot is
+      approximate while producers/consumers are running.
+-----------------------------------------------------------------------------*/
+int mpmc_stats(const ChannelMpmc *chan, ChannelStats *out);
+
 /*-----------------------------------------------------------------------------
   mpmc_destroy
   Frees all memory associated with the channel and waits for all producers and
@@ -219,6 +260,34 @@ void mpmc_close_sender(SenderMpmc *sender);
 -----------------------------------------------------------------------------*/
 int mpmc_send(SenderMpmc *sender, const void *element);
 
+/*-----------------------------------------------------------------------------
+  mpmc_send_batch
+  Sends `count` contiguous elements, claiming all positions at once.
+
+  sender   : pointer to a valid SenderMpmc
+  elements : pointer to count * elem_size bytes
+  count    : number of elements
+  sent     : optional, receives the number of elements published
+
+  Returns:
+    - CHANNEL_OK          on success (also for count == 0), *sent == count
+    - CHANNEL_ERR_NULL    if sender or elements is NULL
+    - CHANNEL_ERR_CLOSED  if channel is closed, possibly mid-batch
+
+  Notes:
+    - One head RMW for the whole batch instead of one per element, the
+      positions are consecutive so other producers cannot interleave.
+    - Elements are published one by one as their slots free up, consumers
+      may start on the first ones while the rest is still being written.
+    - A close while the batch waits for slots stops it: elements[0, *sent)
+      were published and will be received, the rest were not sent (their
+      positions stay empty, receivers see the channel closed there).
+    - The attached signal (if any) is bumped once, after the last element
+      published.
+-----------------------------------------------------------------------------*/
+int mpmc_send_batch(SenderMpmc *sender, const void *elements, size_t count,
+                    size_t *sent);
+
 /*-----------------------------------------------------------------------------
   mpmc_recv
   Receives an element from the channel.
@@ -238,6 +307,88 @@ int mpmc_send(SenderMpmc *sender, const void *element);
 -----------------------------------------------------------------------------*/
 int mpmc_recv(ReceiverMpmc *receiver, void *out);
 
+/*-----------------------------------------------------------------------------
+  mpmc_try_recv
+  Non-blocking mpmc_recv.
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver is NULL
+    - CHANNEL_ERR_EMPTY   if nothing is published at the consumer position
+    - CHANNEL_ERR_CLOSED  if receiver is closed, or channel is closed and
+                          drained
+
+  Notes:
+    - Claims the position with a CAS, so a failed call consumes nothing.
+-----------------------------------------------------------------------------*/
+int mpmc_try_recv(ReceiverMpmc *receiver, void *out);
+
+/*-----------------------------------------------------------------------------
+  mpmc_reserve
+  Claims the next slot of the channel for in-place writing (zero-copy send).
+
+  sender : pointer to a valid SenderMpmc
+  slot   : receives a pointer to elem_size writable bytes
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if sender or slot is NULL
+    - CHANNEL_ERR_FULL    if this sender already holds a reservation
+    - CHANNEL_ERR_CLOSED  if channel is closed
+
+  Notes:
+    - Busy-waits if the ring buffer slot is not available.
+    - The slot is invisible to consumers until mpmc_commit is called.
+    - A sender holds at most one reservation; commit it promptly, consumers
+      behind the claimed slot wait for it.
+-----------------------------------------------------------------------------*/
+int mpmc_reserve(SenderMpmc *sender, void **slot);
+
+/*-----------------------------------------------------------------------------
+  mpmc_commit
+  Publishes the slot obtained with mpmc_reserve.
+
+  sender : pointer to a valid SenderMpmc
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if sender is NULL or nothing is reserved
+-----------------------------------------------------------------------------*/
+int mpmc_commit(SenderMpmc *sender);
+
+/*-----------------------------------------------------------------------------
+  mpmc_peek
+  Claims the next element and exposes it in place (zero-copy receive).
+
+  receiver : pointer to a valid ReceiverMpmc
+  slot     : receives a pointer to elem_size readable bytes
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver or slot is NULL
+    - CHANNEL_ERR_FULL    if this receiver already holds a peeked slot
+    - CHANNEL_ERR_CLOSED  if receiver or channel is closed
+
+  Notes:
+    - Busy-waits until an element becomes available, like mpmc_recv.
+    - The slot is not reused by producers until mpmc_release is called.
+    - A receiver holds at most one peeked slot, release it before peeking
+      again.
+-----------------------------------------------------------------------------*/
+int mpmc_peek(ReceiverMpmc *receiver, void **slot);
+
+/*-----------------------------------------------------------------------------
+  mpmc_release
+  Hands the slot obtained with mpmc_peek back to the producers.
+
+  receiver : pointer to a valid ReceiverMpmc
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver is NULL or nothing is peeked
+-----------------------------------------------------------------------------*/
+int mpmc_release(ReceiverMpmc *receiver);
+
 #endif
 
 #if (defined(MPMC_IMPLEMENTATION))
@@ -260,6 +411,10 @@ typedef struct ChannelMpmc_t {
   _Atomic size_t cons_cont; // Number of active consumers
   _Atomic size_t prod_cont; // Number of active producers
 
+  _Atomic(ChannelSignal *) signal; // optional, see mpmc_set_signal
+#if defined(CHANNEL_TELEMETRY)
+  ChannelTelemetry telemetry;
+#endif
 } ChannelMpmc;
 
 ChannelMpmc *channel_create_mpmc(const size_t capacity,
@@ -284,18 +439,55 @@ ChannelMpmc *channel_create_mpmc(const size_t capacity,
   chan->cons_cont = 0;
   chan->prod_cont = 0;
   chan->state = OPEN;
+  chan->signal = NULL;
+#if defined(CHANNEL_TELEMETRY)
+  _channel_telemetry_init(&chan->telemetry);
+#endif
 
   return chan;
 };
 
 void mpmc_close(ChannelMpmc *chan) {
+  if (!chan) {
+    return;
+  }
   atomic_store_explicit(&chan->state, CLOSED, memory_order_release);
+  _channel_signal_poke(&chan->signal);
 };
 
 ChanState mpmc_is_closed(const ChannelMpmc *chan) {
   return atomic_load_explicit(&chan->state, memory_order_acquire);
 };
 
+void mpmc_set_signal(ChannelMpmc *chan, ChannelSignal *sig) {
+  atomic_store_explicit(&chan->signal, sig, memory_order_release);
+}
+
+size_t mpmc_len(const ChannelMpmc *chan) {
+  if (chan == NULL) {
+    return 0;
+  }
+  size_t head =
+      atomic_load_explicit(&chan->producer.head, memory_order_relaxed);
+  size_t tail =
+      atomic_load_explicit(&chan->consumer.tail, memory_order_relaxed);
+  return head > tail ? head - tail : 0;
+}
+
+int mpmc_stats(const ChannelMpmc *chan, ChannelStats *out) {
+#if defined(CHANNEL_TELEMETRY)
+  if (!chan || !out) {
+    return CHANNEL_ERR_NULL;
+  }
+  _channel_telemetry_snapshot(&chan->telemetry, out);
+  return CHANNEL_OK;
+#else
+  (void)chan;
+  (void)out;
+  return CHANNEL_ERR_NULL;
+#endif
+}
+
 void mpmc_destroy(ChannelMpmc *chan) {
   if (!chan) {
     return;
@@ -326,6 +518,15 @@ typedef struct SenderMpmc_t {
   _Atomic ChanState *chan_state;
   _Atomic size_t *head;
   _Atomic size_t *chan_prod_count;
+
+  Slot *reserved; // slot claimed by mpmc_reserve, NULL if none
+  size_t reserved_pos;
+
+  _Atomic(ChannelSignal *) *signal;
+#if defined(CHANNEL_TELEMETRY)
+  ChannelStatsShard *stats;
+  _Atomic size_t *tail; // occupancy for high_water
+#endif
 } SenderMpmc;
 
 typedef struct ReceiverMpmc_t {
@@ -339,6 +540,12 @@ typedef struct ReceiverMpmc_t {
   _Atomic ChanState receiver_state;
   _Atomic ChanState *chan_state;
   _Atomic size_t *chan_cons_count;
+
+  Slot *peeked; // slot claimed by mpmc_peek, NULL if none
+  size_t peeked_pos;
+#if defined(CHANNEL_TELEMETRY)
+  ChannelStatsShard *stats;
+#endif
 } ReceiverMpmc;
 
 SenderMpmc *mpmc_get_sender(ChannelMpmc *chan) {
@@ -352,10 +559,17 @@ SenderMpmc *mpmc_get_sender(ChannelMpmc *chan) {
   sender->head = &chan->producer.head;
   sender->elem_size = chan->elem_size;
   sender->chan_state = &chan->state;
+  sender->signal = &chan->signal;
   sender->sender_state = OPEN;
 
   atomic_fetch_add_explicit(&chan->prod_cont, 1, memory_order_release);
   sender->chan_prod_count = &chan->prod_cont;
+  sender->reserved = NULL;
+  sender->reserved_pos = 0;
+#if defined(CHANNEL_TELEMETRY)
+  sender->stats = _channel_telemetry_shard(&chan->telemetry);
+  sender->tail = &chan->consumer.tail;
+#endif
   return sender;
 };
 
@@ -373,18 +587,30 @@ ReceiverMpmc *mpmc_get_receiver(ChannelMpmc *chan) {
   receiver->receiver_state = OPEN;
   receiver->chan_state = &chan->state;
 
+  receiver->peeked = NULL;
+  receiver->peeked_pos = 0;
+
   atomic_fetch_add_explicit(&chan->cons_cont, 1, memory_order_release);
   receiver->chan_cons_count = &chan->cons_cont;
+#if defined(CHANNEL_TELEMETRY)
+  receiver->stats = _channel_telemetry_shard(&chan->telemetry);
+#endif
   return receiver;
 };
 
 void mpmc_close_receiver(ReceiverMpmc *receiver) {
+  if (!receiver) {
+    return;
+  }
   atomic_fetch_sub_explicit(receiver->chan_cons_count, 1, memory_order_release);
   atomic_store_explicit(&receiver->receiver_state, CLOSED,
                         memory_order_release);
 };
 
 void mpmc_close_sender(SenderMpmc *sender) {
+  if (!sender) {
+    return;
+  }
   atomic_fetch_sub_explicit(sender->chan_prod_count, 1, memory_order_release);
   atomic_store_explicit(&sender->sender_state, CLOSED, memory_order_release);
 };
@@ -397,6 +623,7 @@ int mpmc_send(SenderMpmc *sender, const void *element) {
       atomic_load_explicit(sender->chan_state, memory_order_acquire);
 
   if (state == CLOSED) {
+    CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
     return CHANNEL_ERR_CLOSED;
   }
 
@@ -404,28 +631,103 @@ int mpmc_send(SenderMpmc *sender, const void *element) {
       atomic_fetch_add_explicit(sender->head, 1, memory_order_acq_rel);
   Slot *slot = &sender->buffer[head % sender->inner_c_cap];
 
+  size_t spins = 0;
   while (atomic_load_explicit(&slot->seq, memory_order_acquire) != head) {
     if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
         CLOSED) {
+      CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
       return CHANNEL_ERR_CLOSED;
     }
+    spins++;
     cpu_relax();
   }
+  CHANNEL_STAT_ADD(sender->stats, full_spins, spins);
 
   memcpy(slot->data, element, sender->elem_size);
 
   // set slot for consumer
   atomic_store_explicit(&slot->seq, head + 1, memory_order_release);
+  _channel_signal_poke(sender->signal);
 
+  CHANNEL_STAT_ADD(sender->stats, sends, 1);
+  CHANNEL_STAT_MAX(sender->stats,
+                   _channel_occupancy(head + 1,
+                                      atomic_load_explicit(
+                                          sender->tail, memory_order_relaxed)));
   return CHANNEL_OK;
 };
 
+int mpmc_send_batch(SenderMpmc *sender, const void *elements, size_t count,
+                    size_t *sent) {
+  if (sent) {
+    *sent = 0;
+  }
+  if (!sender || !elements) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (count == 0) {
+    return CHANNEL_OK;
+  }
+  if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+      CLOSED) {
+    CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
+    return CHANNEL_ERR_CLOSED;
+  }
+
+  size_t head =
+      atomic_fetch_add_explicit(sender->head, count, memory_order_acq_rel);
+
+  int res = CHANNEL_OK;
+  size_t spins = 0;
+  size_t i = 0;
+  for (; i < count; i++) {
+    size_t pos = head + i;
+    Slot *slot = &sender->buffer[pos % sender->inner_c_cap];
+
+    while (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos) {
+      if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+          CLOSED) {
+        CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
+        res = CHANNEL_ERR_CLOSED;
+        break;
+      }
+      spins++;
+      cpu_relax();
+    }
+    if (res != CHANNEL_OK) {
+      break;
+    }
+
+    memcpy(slot->data, (const uint8_t *)elements + i * sender->elem_size,
+           sender->elem_size);
+
+    // set slot for consumer
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+  }
+  if (sent) {
+    *sent = i;
+  }
+  if (i == 0) {
+    return res;
+  }
+  _channel_signal_poke(sender->signal);
+
+  CHANNEL_STAT_ADD(sender->stats, full_spins, spins);
+  CHANNEL_STAT_ADD(sender->stats, sends, i);
+  CHANNEL_STAT_MAX(sender->stats,
+                   _channel_occupancy(head + i,
+                                      atomic_load_explicit(
+                                          sender->tail, memory_order_relaxed)));
+  return res;
+};
+
 int mpmc_recv(ReceiverMpmc *receiver, void *out) {
   if (!receiver) {
     return CHANNEL_ERR_NULL;
   }
   if (atomic_load_explicit(&receiver->receiver_state, memory_order_acquire) ==
       CLOSED) {
+    CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
     return CHANNEL_ERR_CLOSED;
   }
   size_t tail =
@@ -433,18 +735,174 @@ int mpmc_recv(ReceiverMpmc *receiver, void *out) {
 
   Slot *slot = &receiver->buffer[tail % receiver->inner_c_cap];
 
+  size_t spins = 0;
   while (atomic_load_explicit(&slot->seq, memory_order_acquire) != tail + 1) {
     if (atomic_load_explicit(receiver->chan_state, memory_order_acquire) ==
         CLOSED) {
+      CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
       return CHANNEL_ERR_CLOSED;
     }
+    spins++;
     cpu_relax();
   }
+  CHANNEL_STAT_ADD(receiver->stats, empty_spins, spins);
   memcpy(out, slot->data, receiver->elem_size);
 
   // set slot for next future cycle
   atomic_store_explicit(&slot->seq, tail + receiver->inner_c_cap,
                         memory_order_release);
+  CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
+  return CHANNEL_OK;
+};
+
+int mpmc_try_recv(ReceiverMpmc *receiver, void *out) {
+  if (!receiver) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (atomic_load_explicit(&receiver->receiver_state, memory_order_acquire) ==
+      CLOSED) {
+    CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
+    return CHANNEL_ERR_CLOSED;
+  }
+  size_t tail = atomic_load_explicit(receiver->tail, memory_order_acquire);
+
+  for (;;) {
+    Slot *slot = &receiver->buffer[tail % receiver->inner_c_cap];
+    size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)(tail + 1);
+
+    if (diff == 0) {
+      // try to own the position
+      if (atomic_compare_exchange_weak_explicit(receiver->tail, &tail,
+                                                tail + 1, memory_order_acq_rel,
+                                                memory_order_acquire)) {
+        memcpy(out, slot->data, receiver->elem_size);
+
+        // set slot for next future cycle
+        atomic_store_explicit(&slot->seq, tail + receiver->inner_c_cap,
+                              memory_order_release);
+        CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
+        return CHANNEL_OK;
+      }
+    } else if (diff < 0) {
+      if (atomic_load_explicit(receiver->chan_state, memory_order_acquire) ==
+          CLOSED) {
+        // last look, the element may have been published right before close
+        if (atomic_load_explicit(&slot->seq, memory_order_acquire) ==
+            tail + 1) {
+          continue;
+        }
+        CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
+        return CHANNEL_ERR_CLOSED;
+      }
+      CHANNEL_STAT_ADD(receiver->stats, empty_spins, 1);
+      return CHANNEL_ERR_EMPTY;
+    } else {
+      // another consumer took this position
+      tail = atomic_load_explicit(receiver->tail, memory_order_acquire);
+    }
+  }
+};
+
+int mpmc_reserve(SenderMpmc *sender, void **slot_out) {
+  if (!sender || !slot_out) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (sender->reserved) {
+    return CHANNEL_ERR_FULL;
+  }
+  if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+      CLOSED) {
+    CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
+    return CHANNEL_ERR_CLOSED;
+  }
+
+  size_t head =
+      atomic_fetch_add_explicit(sender->head, 1, memory_order_acq_rel);
+  Slot *slot = &sender->buffer[head % sender->inner_c_cap];
+
+  size_t spins = 0;
+  while (atomic_load_explicit(&slot->seq, memory_order_acquire) != head) {
+    if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+        CLOSED) {
+      CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
+      return CHANNEL_ERR_CLOSED;
+    }
+    spins++;
+    cpu_relax();
+  }
+  CHANNEL_STAT_ADD(sender->stats, full_spins, spins);
+
+  sender->reserved = slot;
+  sender->reserved_pos = head;
+  *slot_out = slot->data;
+  return CHANNEL_OK;
+};
+
+int mpmc_commit(SenderMpmc *sender) {
+  if (!sender || !sender->reserved) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  // set slot for consumer
+  atomic_store_explicit(&sender->reserved->seq, sender->reserved_pos + 1,
+                        memory_order_release);
+  _channel_signal_poke(sender->signal);
+  sender->reserved = NULL;
+  CHANNEL_STAT_ADD(sender->stats, sends, 1);
+  CHANNEL_STAT_MAX(sender->stats,
+                   _channel_occupancy(sender->reserved_pos + 1,
+                                      atomic_load_explicit(
+                                          sender->tail, memory_order_relaxed)));
+  return CHANNEL_OK;
+};
+
+int mpmc_peek(ReceiverMpmc *receiver, void **slot_out) {
+  if (!receiver || !slot_out) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (receiver->peeked) {
+    return CHANNEL_ERR_FULL;
+  }
+  if (atomic_load_explicit(&receiver->receiver_state, memory_order_acquire) ==
+      CLOSED) {
+    CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
+    return CHANNEL_ERR_CLOSED;
+  }
+  size_t tail =
+      atomic_fetch_add_explicit(receiver->tail, 1, memory_order_acq_rel);
+
+  Slot *slot = &receiver->buffer[tail % receiver->inner_c_cap];
+
+  size_t spins = 0;
+  while (atomic_load_explicit(&slot->seq, memory_order_acquire) != tail + 1) {
+    if (atomic_load_explicit(receiver->chan_state, memory_order_acquire) ==
+        CLOSED) {
+      CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
+      return CHANNEL_ERR_CLOSED;
+    }
+    spins++;
+    cpu_relax();
+  }
+  CHANNEL_STAT_ADD(receiver->stats, empty_spins, spins);
+
+  receiver->peeked = slot;
+  receiver->peeked_pos = tail;
+  *slot_out = slot->data;
+  return CHANNEL_OK;
+};
+
+int mpmc_release(ReceiverMpmc *receiver) {
+  if (!receiver || !receiver->peeked) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  // set slot for next future cycle
+  atomic_store_explicit(&receiver->peeked->seq,
+                        receiver->peeked_pos + receiver->inner_c_cap,
+                        memory_order_release);
+  receiver->peeked = NULL;
+  CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
   return CHANNEL_OK;
 };
 #endif
@@ -130,6 +130,36 @@ void mpsc_close(ChannelMpsc *chan);
 -----------------------------------------------------------------------------*/
 ChanState mpsc_is_closed(const ChannelMpsc *chan);
 
+/*-----------------------------------------------------------------------------
+  mpsc_set_signal
+  Attaches a ChannelSignal that senders bump after each publish and on close.
+
+  chan : pointer to the channel
+  sig  : signal to attach, NULL to detach
+
+  Notes:
+    - Several channels may share one signal (see select.h).
+    - Attach before handing out senders or while they are idle.
+-----------------------------------------------------------------------------*/
+void mpsc_set_signal(ChannelMpsc *chan, ChannelSignal *sig);
+
+/*-----------------------------------------------------------------------------
+  mpsc_stats
+  Copies the channel's telemetry counters into `out`.
+
+  chan : pointer to the channel
+  out  : receives the snapshot
+
+  Returns:
+    - CHANNEL_OK        on success
+    - CHANNEL_ERR_NULL  if an argument is NULL or CHANNEL_TELEMETRY is off
+
+  Notes:
+    - Counters are read without stopping the channel, the snapshot is
+      approximate while producers/consumers are running.
+-----------------------------------------------------------------------------*/
+int mpsc_stats(const ChannelMpsc *chan, ChannelStats *out);
+
 /*-----------------------------------------------------------------------------
   mpsc_destroy
   Frees all memory associated with the channel and waits for all producers
@@ -216,7 +246,8 @@ int mpsc_send(SenderMpsc *sender, const void *element);
   Returns:
     - CHANNEL_OK          on success
     - CHANNEL_ERR_NULL    if receiver is NULL
-    - CHANNEL_ERR_EMPTY   if no new element is available
+    - CHANNEL_ERR_EMPTY   if no new element is available, or a mpsc_peek
+                          slot is pending (release it first)
 
   Notes:
     - Only one consumer is supported.
@@ -225,6 +256,72 @@ int mpsc_send(SenderMpsc *sender, const void *element);
 -----------------------------------------------------------------------------*/
 int mpsc_recv(ReceiverMpsc *receiver, void *out);
 
+/*-----------------------------------------------------------------------------
+  mpsc_reserve
+  Claims the next slot of the channel for in-place writing (zero-copy send).
+
+  sender : pointer to a valid SenderMpsc
+  slot   : receives a pointer to elem_size writable bytes
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if sender or slot is NULL
+    - CHANNEL_ERR_FULL    if this sender already holds a reservation
+    - CHANNEL_ERR_CLOSED  if channel is closed
+
+  Notes:
+    - Busy-waits if the ring buffer slot is not available.
+    - The slot is invisible to consumers until mpsc_commit is called.
+    - A sender holds at most one reservation; commit it promptly, consumers
+      behind the claimed slot wait for it.
+-----------------------------------------------------------------------------*/
+int mpsc_reserve(SenderMpsc *sender, void **slot);
+
+/*-----------------------------------------------------------------------------
+  mpsc_commit
+  Publishes the slot obtained with mpsc_reserve.
+
+  sender : pointer to a valid SenderMpsc
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if sender is NULL or nothing is reserved
+-----------------------------------------------------------------------------*/
+int mpsc_commit(SenderMpsc *sender);
+
+/*-----------------------------------------------------------------------------
+  mpsc_peek
+  Claims the next element and exposes it in place (zero-copy receive).
+
+  receiver : pointer to a valid ReceiverMpsc
+  slot     : receives a pointer to elem_size readable bytes
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver or slot is NULL
+    - CHANNEL_ERR_EMPTY   if no new element is available
+    - CHANNEL_ERR_FULL    if a peek is pending
+
+  Notes:
+    - Non-blocking, like mpsc_recv.
+    - The slot is not reused by producers until mpsc_release is called.
+    - A receiver holds at most one peeked slot, release it before peeking
+      again.
+-----------------------------------------------------------------------------*/
+int mpsc_peek(ReceiverMpsc *receiver, void **slot);
+
+/*-----------------------------------------------------------------------------
+  mpsc_release
+  Hands the slot obtained with mpsc_peek back to the producers.
+
+  receiver : pointer to a valid ReceiverMpsc
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver is NULL or nothing is peeked
+-----------------------------------------------------------------------------*/
+int mpsc_release(ReceiverMpsc *receiver);
+
 #endif
 
 #if (defined(MPSC_IMPLEMENTATION))
@@ -244,6 +341,10 @@ typedef struct ChannelMpsc_t {
 
   _Atomic size_t prod_cont; // Number of active producers
   _Atomic ChanState state;  // 0 -> Open | 1 -> Closed
+  _Atomic(ChannelSignal *) signal; // optional, see mpsc_set_signal
+#if defined(CHANNEL_TELEMETRY)
+  ChannelTelemetry telemetry;
+#endif
 } ChannelMpsc;
 
 ChannelMpsc *channel_create_mpsc(const size_t capacity,
@@ -280,18 +381,41 @@ ChannelMpsc *channel_create_mpsc(const size_t capacity,
   chan->consumer.tail = 0;
   chan->prod_cont = 0;
   chan->state = OPEN;
+  chan->signal = NULL;
+#if defined(CHANNEL_TELEMETRY)
+  _channel_telemetry_init(&chan->telemetry);
+#endif
 
   return chan;
 };
 
 void mpsc_close(ChannelMpsc *chan) {
   atomic_store_explicit(&chan->state, CLOSED, memory_order_release);
+  _channel_signal_poke(&chan->signal);
 }
 
 ChanState mpsc_is_closed(const ChannelMpsc *chan) {
   return atomic_load_explicit(&chan->state, memory_order_acquire);
 }
 
+void mpsc_set_signal(ChannelMpsc *chan, ChannelSignal *sig) {
+  atomic_store_explicit(&chan->signal, sig, memory_order_release);
+}
+
+int mpsc_stats(const ChannelMpsc *chan, ChannelStats *out) {
+#if defined(CHANNEL_TELEMETRY)
+  if (!chan || !out) {
+    return CHANNEL_ERR_NULL;
+  }
+  _channel_telemetry_snapshot(&chan->telemetry, out);
+  return CHANNEL_OK;
+#else
+  (void)chan;
+  (void)out;
+  return CHANNEL_ERR_NULL;
+#endif
+}
+
 void mpsc_destroy(ChannelMpsc *chan) {
   if (!chan) {
     return;
@@ -323,6 +447,14 @@ typedef struct SenderMpsc_t {
   _Atomic size_t *chan_prod_count;
   _Atomic ChanState *chan_state;
   _Atomic ChanState sender_state;
+
+  Slot *reserved; // slot claimed by mpsc_reserve, NULL if none
+  size_t reserved_pos;
+
+  _Atomic(ChannelSignal *) *signal;
+#if defined(CHANNEL_TELEMETRY)
+  ChannelStatsShard *stats;
+#endif
 } SenderMpsc;
 
 typedef struct ReceiverMpsc_t {
@@ -332,6 +464,12 @@ typedef struct ReceiverMpsc_t {
 
   _Atomic size_t *head;
   _Atomic size_t *tail;
+
+  Slot *peeked; // slot exposed by mpsc_peek, NULL if none
+  size_t peeked_pos;
+#if defined(CHANNEL_TELEMETRY)
+  ChannelStatsShard *stats;
+#endif
 } ReceiverMpsc;
 
 SenderMpsc *mpsc_get_sender(ChannelMpsc *chan) {
@@ -346,11 +484,17 @@ SenderMpsc *mpsc_get_sender(ChannelMpsc *chan) {
   sender->tail = &chan->consumer.tail;
   sender->elem_size = chan->elem_size;
   sender->chan_state = &chan->state;
+  sender->signal = &chan->signal;
   sender->sender_state = OPEN;
+  sender->reserved = NULL;
+  sender->reserved_pos = 0;
 
   atomic_fetch_add_explicit(&chan->prod_cont, 1, memory_order_release);
   sender->chan_prod_count = &chan->prod_cont;
 
+#if defined(CHANNEL_TELEMETRY)
+  sender->stats = _channel_telemetry_shard(&chan->telemetry);
+#endif
   return sender;
 }
 
@@ -365,7 +509,12 @@ ReceiverMpsc *mpsc_get_receiver(ChannelMpsc *chan) {
   receiver->tail = &chan->consumer.tail;
   receiver->head = &chan->producer.head;
   receiver->elem_size = chan->elem_size;
+  receiver->peeked = NULL;
+  receiver->peeked_pos = 0;
 
+#if defined(CHANNEL_TELEMETRY)
+  receiver->stats = _channel_telemetry_shard(&chan->telemetry);
+#endif
   return receiver;
 }
 
@@ -382,6 +531,7 @@ int mpsc_send(SenderMpsc *sender, const void *element) {
       atomic_load_explicit(sender->chan_state, memory_order_acquire);
 
   if (state == CLOSED) {
+    CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
     return CHANNEL_ERR_CLOSED;
   }
 
@@ -389,19 +539,29 @@ int mpsc_send(SenderMpsc *sender, const void *element) {
       atomic_fetch_add_explicit(sender->head, 1, memory_order_acq_rel);
   Slot *slot = &sender->buffer[head % sender->inner_c_cap];
 
+  size_t spins = 0;
   while (atomic_load_explicit(&slot->seq, memory_order_acquire) != head) {
     if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
         CLOSED) {
+      CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
       return CHANNEL_ERR_CLOSED;
     }
+    spins++;
     cpu_relax();
   }
+  CHANNEL_STAT_ADD(sender->stats, full_spins, spins);
 
   memcpy(slot->data, element, sender->elem_size);
 
   // set slot for consumer
   atomic_store_explicit(&slot->seq, head + 1, memory_order_release);
+  _channel_signal_poke(sender->signal);
 
+  CHANNEL_STAT_ADD(sender->stats, sends, 1);
+  CHANNEL_STAT_MAX(sender->stats,
+                   _channel_occupancy(head + 1,
+                                      atomic_load_explicit(
+                                          sender->tail, memory_order_relaxed)));
   return CHANNEL_OK;
 }
 
@@ -409,13 +569,19 @@ int mpsc_recv(ReceiverMpsc *receiver, void *out) {
   if (!receiver) {
     return CHANNEL_ERR_NULL;
   }
+  // the oldest element is the peeked one, mpsc_release recycles it
+  if (receiver->peeked) {
+    return CHANNEL_ERR_EMPTY;
+  }
   size_t tail = atomic_load_explicit(receiver->tail, memory_order_relaxed);
   size_t head = atomic_load_explicit(receiver->head, memory_order_acquire);
   if (tail == head) {
+    CHANNEL_STAT_ADD(receiver->stats, empty_spins, 1);
     return CHANNEL_ERR_EMPTY;
   }
   Slot *slot = &receiver->buffer[tail % receiver->inner_c_cap];
   if (atomic_load_explicit(&slot->seq, memory_order_acquire) != tail + 1) {
+    CHANNEL_STAT_ADD(receiver->stats, empty_spins, 1);
     return CHANNEL_ERR_EMPTY;
   }
 
@@ -425,6 +591,100 @@ int mpsc_recv(ReceiverMpsc *receiver, void *out) {
   atomic_store_explicit(&slot->seq, tail + receiver->inner_c_cap,
                         memory_order_release);
   atomic_fetch_add_explicit(receiver->tail, 1, memory_order_relaxed);
+  CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
+  return CHANNEL_OK;
+}
+
+int mpsc_reserve(SenderMpsc *sender, void **slot_out) {
+  if (!sender || !slot_out) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (sender->reserved) {
+    return CHANNEL_ERR_FULL;
+  }
+  if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+      CLOSED) {
+    CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
+    return CHANNEL_ERR_CLOSED;
+  }
+
+  size_t head =
+      atomic_fetch_add_explicit(sender->head, 1, memory_order_acq_rel);
+  Slot *slot = &sender->buffer[head % sender->inner_c_cap];
+
+  size_t spins = 0;
+  while (atomic_load_explicit(&slot->seq, memory_order_acquire) != head) {
+    if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+        CLOSED) {
+      CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
+      return CHANNEL_ERR_CLOSED;
+    }
+    spins++;
+    cpu_relax();
+  }
+  CHANNEL_STAT_ADD(sender->stats, full_spins, spins);
+
+  sender->reserved = slot;
+  sender->reserved_pos = head;
+  *slot_out = slot->data;
+  return CHANNEL_OK;
+}
+
+int mpsc_commit(SenderMpsc *sender) {
+  if (!sender || !sender->reserved) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  // set slot for consumer
+  atomic_store_explicit(&sender->reserved->seq, sender->reserved_pos + 1,
+                        memory_order_release);
+  _channel_signal_poke(sender->signal);
+  sender->reserved = NULL;
+  CHANNEL_STAT_ADD(sender->stats, sends, 1);
+  CHANNEL_STAT_MAX(sender->stats,
+                   _channel_occupancy(sender->reserved_pos + 1,
+                                      atomic_load_explicit(
+                                          sender->tail, memory_order_relaxed)));
+  return CHANNEL_OK;
+}
+
+int mpsc_peek(ReceiverMpsc *receiver, void **slot_out) {
+  if (!receiver || !slot_out) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (receiver->peeked) {
+    return CHANNEL_ERR_FULL;
+  }
+  size_t tail = atomic_load_explicit(receiver->tail, memory_order_relaxed);
+  size_t head = atomic_load_explicit(receiver->head, memory_order_acquire);
+  if (tail == head) {
+    CHANNEL_STAT_ADD(receiver->stats, empty_spins, 1);
+    return CHANNEL_ERR_EMPTY;
+  }
+  Slot *slot = &receiver->buffer[tail % receiver->inner_c_cap];
+  if (atomic_load_explicit(&slot->seq, memory_order_acquire) != tail + 1) {
+    CHANNEL_STAT_ADD(receiver->stats, empty_spins, 1);
+    return CHANNEL_ERR_EMPTY;
+  }
+
+  receiver->peeked = slot;
+  receiver->peeked_pos = tail;
+  *slot_out = slot->data;
+  return CHANNEL_OK;
+}
+
+int mpsc_release(ReceiverMpsc *receiver) {
+  if (!receiver || !receiver->peeked) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  // set slot for next future cycle
+  atomic_store_explicit(&receiver->peeked->seq,
+                        receiver->peeked_pos + receiver->inner_c_cap,
+                        memory_order_release);
+  atomic_fetch_add_explicit(receiver->tail, 1, memory_order_relaxed);
+  receiver->peeked = NULL;
+  CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
   return CHANNEL_OK;
 }
 #endif
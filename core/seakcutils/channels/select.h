@@ -0,0 +1,200 @@
+// Copyright 2025 Seaker <seakerone@proton.me>
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+------------------------------------------------------------------------------
+select.h — Wait on several channels at once
+
+A consumer that services more than one channel (input events, finished
+jobs, control messages, ...) would otherwise round-robin try_recv calls
+in a hot loop. channel_select() tries every case in order and, when all
+of them are empty, sleeps on a ChannelSignal shared by the channels until
+a producer publishes into any of them.
+
+------------------------------------------------------------------------------
+SETUP
+
+    ChannelSignal sig;
+    channel_signal_init(&sig);
+    mpmc_set_signal(jobs_done, &sig);
+    spsc_set_signal(control, &sig);
+
+The signal must outlive the channels it is attached to.
+
+------------------------------------------------------------------------------
+SEMANTICS
+
+- Cases are tried in array order: put the most urgent channel first.
+- The winning case RECEIVES its element into `out` (there is no "ready
+  but not taken" state, which would race with other consumers).
+- A case whose try_recv reports CHANNEL_ERR_CLOSED stays in the set; when
+  every case is closed, channel_select returns CHANNEL_ERR_CLOSED.
+- SPSC and MPSC receivers cannot observe close (their recv only reports
+  EMPTY), select on them relies on the timeout or another case.
+
+Only channel kinds whose header was included before this one can be used
+in a case, the others report CHANNEL_ERR_NULL.
+
+------------------------------------------------------------------------------
+USAGE
+
+In exactly ONE source file, after the channel headers:
+
+    #define CHANNEL_SELECT_IMPLEMENTATION
+    #include "select.h"
+
+------------------------------------------------------------------------------
+*/
+#ifndef CHANNEL_SELECT_H
+#define CHANNEL_SELECT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum ChannelSelectKind_t {
+  CHANNEL_SELECT_SPSC = 0,
+  CHANNEL_SELECT_MPSC,
+  CHANNEL_SELECT_SPMC,
+  CHANNEL_SELECT_MPMC,
+  CHANNEL_SELECT_MCAST,
+  CHANNEL_SELECT_UNBOUNDED,
+} ChannelSelectKind;
+
+// One receive operation of a select.
+// kind     : which channel type `receiver` belongs to
+// receiver : ReceiverSpsc*, ReceiverMpmc*, ... matching `kind`
+// out      : where the element is copied when this case wins
+typedef struct ChannelSelectCase_t {
+  ChannelSelectKind kind;
+  void *receiver;
+  void *out;
+} ChannelSelectCase;
+
+/*-----------------------------------------------------------------------------
+  channel_select
+  Receives from the first case that has an element, sleeping on `sig`
+  while all of them are empty.
+
+  sig        : signal attached to every channel in `cases` (may be NULL
+               for a single non-blocking pass)
+  cases      : receive operations, tried in order
+  num_cases  : number of entries in cases
+  timeout_ns : 0 for a single pass, negative to wait forever
+
+  Returns:
+    - index of the case that received (>= 0)
+    - CHANNEL_ERR_NULL    if cases is NULL/empty or a case is invalid
+    - CHANNEL_ERR_EMPTY   if the timeout expired
+    - CHANNEL_ERR_CLOSED  if every case is closed and drained
+-----------------------------------------------------------------------------*/
+int channel_select(ChannelSignal *sig, ChannelSelectCase *cases,
+                   size_t num_cases, int64_t timeout_ns);
+
+#endif
+
+#if (defined(CHANNEL_SELECT_IMPLEMENTATION))
+#include <stdatomic.h>
+#include <time.h>
+
+static int _channel_select_try(ChannelSelectCase *c) {
+  switch (c->kind) {
+#if defined(SPSC_CHANNEL_H)
+  case CHANNEL_SELECT_SPSC:
+    return spsc_recv((ReceiverSpsc *)c->receiver, c->out);
+#endif
+#if defined(MPSC_CHANNEL_H)
+  case CHANNEL_SELECT_MPSC:
+    return mpsc_recv((ReceiverMpsc *)c->receiver, c->out);
+#endif
+#if defined(SPMC_CHANNEL_H)
+  case CHANNEL_SELECT_SPMC:
+    return spmc_try_recv((ReceiverSpmc *)c->receiver, c->out);
+#endif
+#if defined(MPMC_CHANNEL_H)
+  case CHANNEL_SELECT_MPMC:
+    return mpmc_try_recv((ReceiverMpmc *)c->receiver, c->out);
+#endif
+#if defined(MCAST_CHANNEL_H)
+  case CHANNEL_SELECT_MCAST:
+    return mcast_try_recv((ReceiverMcast *)c->receiver, c->out);
+#endif
+#if defined(UNBOUNDED_CHANNEL_H)
+  case CHANNEL_SELECT_UNBOUNDED:
+    return unbounded_try_recv((ReceiverUnbounded *)c->receiver, c->out);
+#endif
+  default:
+    return CHANNEL_ERR_NULL;
+  }
+}
+
+static int64_t _channel_select_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+int channel_select(ChannelSignal *sig, ChannelSelectCase *cases,
+                   size_t num_cases, int64_t timeout_ns) {
+  if (!cases || num_cases == 0) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  int64_t deadline = 0;
+  if (timeout_ns > 0) {
+    deadline = _channel_select_now_ns() + timeout_ns;
+  }
+
+  for (;;) {
+    // read the sequence BEFORE looking at the channels: a publish that
+    // lands after the scan moves it and the wait returns immediately
+    uint32_t seen =
+        sig ? atomic_load_explicit(&sig->seq, memory_order_seq_cst) : 0;
+
+    size_t closed = 0;
+    for (size_t x = 0; x < num_cases; x++) {
+      int res = _channel_select_try(&cases[x]);
+      if (res == CHANNEL_OK) {
+        return (int)x;
+      }
+      if (res == CHANNEL_ERR_CLOSED) {
+        closed++;
+      } else if (res == CHANNEL_ERR_NULL) {
+        return CHANNEL_ERR_NULL;
+      }
+    }
+
+    if (closed == num_cases) {
+      return CHANNEL_ERR_CLOSED;
+    }
+    if (!sig || timeout_ns == 0) {
+      return CHANNEL_ERR_EMPTY;
+    }
+
+    int64_t wait_ns = -1;
+    if (timeout_ns > 0) {
+      wait_ns = deadline - _channel_select_now_ns();
+      if (wait_ns <= 0) {
+        return CHANNEL_ERR_EMPTY;
+      }
+    }
+    channel_signal_wait(sig, seen, wait_ns);
+  }
+}
+#endif
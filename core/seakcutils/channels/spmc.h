@@ -131,6 +131,36 @@ void spmc_close(ChannelSpmc *chan);
 -----------------------------------------------------------------------------*/
 ChanState spmc_is_closed(const ChannelSpmc *chan);
 
+/*-----------------------------------------------------------------------------
+  spmc_set_signal
+  Attaches a ChannelSignal that senders bump after each publish and on close.
+
+  chan : pointer to the channel
+  sig  : signal to attach, NULL to detach
+
+  Notes:
+    - Several channels may share one signal (see select.h).
+    - Attach before handing out senders or while they are idle.
+-----------------------------------------------------------------------------*/
+void spmc_set_signal(ChannelSpmc *chan, ChannelSignal *sig);
+
+/*-----------------------------------------------------------------------------
+  spmc_stats
+  Copies the channel's telemetry counters into `out`.
+
+  chan : pointer to the channel
+  out  : receives the snapshot
+
+  Returns:
+    - CHANNEL_OK        on success
+    - CHANNEL_ERR_NULL  if an argument is NULL or CHANNEL_TELEMETRY is off
+
+  Notes:
+    - Counters are read without stopping the channel, the snapshot is
+      approximate while producers/consumers are running.
+-----------------------------------------------------------------------------*/
+int spmc_stats(const ChannelSpmc *chan, ChannelStats *out);
+
 /*-----------------------------------------------------------------------------
   spmc_destroy
   Frees all memory associated with the channel and waits for all consumers
@@ -228,8 +258,86 @@ int spmc_send(SenderSpmc *sender, const void *element);
 -----------------------------------------------------------------------------*/
 int spmc_recv(ReceiverSpmc *receiver, void *out);
 
+/*-----------------------------------------------------------------------------
+  spmc_try_recv
+  Non-blocking spmc_recv.
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver is NULL
+    - CHANNEL_ERR_EMPTY   if nothing is available, or another consumer won
+                          the position
+    - CHANNEL_ERR_CLOSED  if receiver is closed, or channel is closed and
+                          drained
+-----------------------------------------------------------------------------*/
 int spmc_try_recv(ReceiverSpmc *receiver, void *out);
 
+/*-----------------------------------------------------------------------------
+  spmc_reserve
+  Claims the next slot of the channel for in-place writing (zero-copy send).
+
+  sender : pointer to a valid SenderSpmc
+  slot   : receives a pointer to elem_size writable bytes
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if sender or slot is NULL
+    - CHANNEL_ERR_FULL    if this sender already holds a reservation
+    - CHANNEL_ERR_CLOSED  if channel is closed
+
+  Notes:
+    - Busy-waits if the ring buffer slot is not available.
+    - The slot is invisible to consumers until spmc_commit is called.
+    - A sender holds at most one reservation; commit it promptly, consumers
+      behind the claimed slot wait for it.
+-----------------------------------------------------------------------------*/
+int spmc_reserve(SenderSpmc *sender, void **slot);
+
+/*-----------------------------------------------------------------------------
+  spmc_commit
+  Publishes the slot obtained with spmc_reserve.
+
+  sender : pointer to a valid SenderSpmc
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if sender is NULL or nothing is reserved
+-----------------------------------------------------------------------------*/
+int spmc_commit(SenderSpmc *sender);
+
+/*-----------------------------------------------------------------------------
+  spmc_peek
+  Claims the next element and exposes it in place (zero-copy receive).
+
+  receiver : pointer to a valid ReceiverSpmc
+  slot     : receives a pointer to elem_size readable bytes
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver or slot is NULL
+    - CHANNEL_ERR_FULL    if this receiver already holds a peeked slot
+    - CHANNEL_ERR_CLOSED  if receiver or channel is closed
+
+  Notes:
+    - Busy-waits until an element becomes available, like spmc_recv.
+    - The slot is not reused by producers until spmc_release is called.
+    - A receiver holds at most one peeked slot, release it before peeking
+      again.
+-----------------------------------------------------------------------------*/
+int spmc_peek(ReceiverSpmc *receiver, void **slot);
+
+/*-----------------------------------------------------------------------------
+  spmc_release
+  Hands the slot obtained with spmc_peek back to the producers.
+
+  receiver : pointer to a valid ReceiverSpmc
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver is NULL or nothing is peeked
+-----------------------------------------------------------------------------*/
+int spmc_release(ReceiverSpmc *receiver);
+
 #endif
 
 #if (defined(SPMC_IMPLEMENTATION))
@@ -250,6 +358,10 @@ typedef struct ChannelSpmc_t {
   _Atomic size_t cons_cont; // Number of active consumers
   _Atomic ChanState state;  // 0 -> Open | 1 -> Closed
 
+  _Atomic(ChannelSignal *) signal; // optional, see spmc_set_signal
+#if defined(CHANNEL_TELEMETRY)
+  ChannelTelemetry telemetry;
+#endif
 } ChannelSpmc;
 
 ChannelSpmc *channel_create_spmc(const size_t capacity,
@@ -273,18 +385,41 @@ ChannelSpmc *channel_create_spmc(const size_t capacity,
   chan->consumer.tail = 0;
   chan->cons_cont = 0;
   chan->state = OPEN;
+  chan->signal = NULL;
+#if defined(CHANNEL_TELEMETRY)
+  _channel_telemetry_init(&chan->telemetry);
+#endif
 
   return chan;
 };
 
 void spmc_close(ChannelSpmc *chan) {
   atomic_store_explicit(&chan->state, CLOSED, memory_order_release);
+  _channel_signal_poke(&chan->signal);
 };
 
 ChanState spmc_is_closed(const ChannelSpmc *chan) {
   return atomic_load_explicit(&chan->state, memory_order_acquire);
 };
 
+void spmc_set_signal(ChannelSpmc *chan, ChannelSignal *sig) {
+  atomic_store_explicit(&chan->signal, sig, memory_order_release);
+}
+
+int spmc_stats(const ChannelSpmc *chan, ChannelStats *out) {
+#if defined(CHANNEL_TELEMETRY)
+  if (!chan || !out) {
+    return CHANNEL_ERR_NULL;
+  }
+  _channel_telemetry_snapshot(&chan->telemetry, out);
+  return CHANNEL_OK;
+#else
+  (void)chan;
+  (void)out;
+  return CHANNEL_ERR_NULL;
+#endif
+}
+
 void spmc_destroy(ChannelSpmc *chan) {
   if (!chan) {
     return;
@@ -311,6 +446,15 @@ typedef struct SenderSpmc_t {
 
   _Atomic ChanState *chan_state;
   _Atomic size_t *head;
+
+  Slot *reserved; // slot claimed by spmc_reserve, NULL if none
+  size_t reserved_pos;
+
+  _Atomic(ChannelSignal *) *signal;
+#if defined(CHANNEL_TELEMETRY)
+  ChannelStatsShard *stats;
+  _Atomic size_t *tail; // occupancy for high_water
+#endif
 } SenderSpmc;
 
 typedef struct ReceiverSpmc_t {
@@ -324,6 +468,12 @@ typedef struct ReceiverSpmc_t {
   _Atomic ChanState receiver_state;
   _Atomic ChanState *chan_state;
   _Atomic size_t *chan_cons_count;
+
+  Slot *peeked; // slot claimed by spmc_peek, NULL if none
+  size_t peeked_pos;
+#if defined(CHANNEL_TELEMETRY)
+  ChannelStatsShard *stats;
+#endif
 } ReceiverSpmc;
 
 SenderSpmc *spmc_get_sender(ChannelSpmc *chan) {
@@ -337,7 +487,14 @@ SenderSpmc *spmc_get_sender(ChannelSpmc *chan) {
   sender->head = &chan->producer.head;
   sender->elem_size = chan->elem_size;
   sender->chan_state = &chan->state;
+  sender->signal = &chan->signal;
 
+  sender->reserved = NULL;
+  sender->reserved_pos = 0;
+#if defined(CHANNEL_TELEMETRY)
+  sender->stats = _channel_telemetry_shard(&chan->telemetry);
+  sender->tail = &chan->consumer.tail;
+#endif
   return sender;
 };
 
@@ -355,8 +512,14 @@ ReceiverSpmc *spmc_get_receiver(ChannelSpmc *chan) {
   receiver->receiver_state = OPEN;
   receiver->chan_state = &chan->state;
 
+  receiver->peeked = NULL;
+  receiver->peeked_pos = 0;
+
   atomic_fetch_add_explicit(&chan->cons_cont, 1, memory_order_release);
   receiver->chan_cons_count = &chan->cons_cont;
+#if defined(CHANNEL_TELEMETRY)
+  receiver->stats = _channel_telemetry_shard(&chan->telemetry);
+#endif
   return receiver;
 };
 
@@ -374,6 +537,7 @@ int spmc_send(SenderSpmc *sender, const void *element) {
       atomic_load_explicit(sender->chan_state, memory_order_acquire);
 
   if (state == CLOSED) {
+    CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
     return CHANNEL_ERR_CLOSED;
   }
 
@@ -381,19 +545,29 @@ int spmc_send(SenderSpmc *sender, const void *element) {
       atomic_fetch_add_explicit(sender->head, 1, memory_order_acq_rel);
   Slot *slot = &sender->buffer[head % sender->inner_c_cap];
 
+  size_t spins = 0;
   while (atomic_load_explicit(&slot->seq, memory_order_acquire) != head) {
     if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
         CLOSED) {
+      CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
       return CHANNEL_ERR_CLOSED;
     }
+    spins++;
     cpu_relax();
   }
+  CHANNEL_STAT_ADD(sender->stats, full_spins, spins);
 
   memcpy(slot->data, element, sender->elem_size);
 
   // set slot for consumer
   atomic_store_explicit(&slot->seq, head + 1, memory_order_release);
+  _channel_signal_poke(sender->signal);
 
+  CHANNEL_STAT_ADD(sender->stats, sends, 1);
+  CHANNEL_STAT_MAX(sender->stats,
+                   _channel_occupancy(head + 1,
+                                      atomic_load_explicit(
+                                          sender->tail, memory_order_relaxed)));
   return CHANNEL_OK;
 };
 
@@ -403,6 +577,7 @@ int spmc_recv(ReceiverSpmc *receiver, void *out) {
   }
   if (atomic_load_explicit(&receiver->receiver_state, memory_order_acquire) ==
       CLOSED) {
+    CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
     return CHANNEL_ERR_CLOSED;
   }
   size_t tail =
@@ -410,18 +585,23 @@ int spmc_recv(ReceiverSpmc *receiver, void *out) {
 
   Slot *slot = &receiver->buffer[tail % receiver->inner_c_cap];
 
+  size_t spins = 0;
   while (atomic_load_explicit(&slot->seq, memory_order_acquire) != tail + 1) {
     if (atomic_load_explicit(receiver->chan_state, memory_order_acquire) ==
         CLOSED) {
+      CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
       return CHANNEL_ERR_CLOSED;
     }
+    spins++;
     cpu_relax();
   }
+  CHANNEL_STAT_ADD(receiver->stats, empty_spins, spins);
   memcpy(out, slot->data, receiver->elem_size);
 
   // set slot for next future cycle
   atomic_store_explicit(&slot->seq, tail + receiver->inner_c_cap,
                         memory_order_release);
+  CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
   return CHANNEL_OK;
 };
 
@@ -431,32 +611,146 @@ int spmc_try_recv(ReceiverSpmc *receiver, void *out) {
   }
   if (atomic_load_explicit(&receiver->receiver_state, memory_order_acquire) ==
       CLOSED) {
+    CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
     return CHANNEL_ERR_CLOSED;
   }
   size_t tail = atomic_load_explicit(receiver->tail, memory_order_acquire);
 
   Slot *slot = &receiver->buffer[tail % receiver->inner_c_cap];
 
-  if (atomic_load_explicit(&slot->seq, memory_order_acquire) != tail + 1) {
+  size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+  if (seq != tail + 1) {
+    if ((intptr_t)seq - (intptr_t)(tail + 1) < 0 &&
+        atomic_load_explicit(receiver->chan_state, memory_order_acquire) ==
+            CLOSED &&
+        atomic_load_explicit(&slot->seq, memory_order_acquire) != tail + 1) {
+      return CHANNEL_ERR_CLOSED; // closed and drained
+    }
+    CHANNEL_STAT_ADD(receiver->stats, empty_spins, 1);
     return CHANNEL_ERR_EMPTY;
   }
 
   // try to own the position
   if (atomic_load_explicit(&receiver->receiver_state, memory_order_acquire) ==
       CLOSED) {
+    CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
     return CHANNEL_ERR_CLOSED;
   }
   if (!atomic_compare_exchange_strong_explicit(receiver->tail, &tail, tail + 1,
                                                memory_order_acq_rel,
-                                               memory_order_relaxed))
+                                               memory_order_relaxed)) {
+    CHANNEL_STAT_ADD(receiver->stats, empty_spins, 1);
     return CHANNEL_ERR_EMPTY; // Another consumer won the race
+  }
 
   memcpy(out, slot->data, receiver->elem_size);
 
   // set slot for next future cycle
   atomic_store_explicit(&slot->seq, tail + receiver->inner_c_cap,
                         memory_order_release);
+  CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
   return CHANNEL_OK;
 }
 
+int spmc_reserve(SenderSpmc *sender, void **slot_out) {
+  if (!sender || !slot_out) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (sender->reserved) {
+    return CHANNEL_ERR_FULL;
+  }
+  if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+      CLOSED) {
+    CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
+    return CHANNEL_ERR_CLOSED;
+  }
+
+  size_t head =
+      atomic_fetch_add_explicit(sender->head, 1, memory_order_acq_rel);
+  Slot *slot = &sender->buffer[head % sender->inner_c_cap];
+
+  size_t spins = 0;
+  while (atomic_load_explicit(&slot->seq, memory_order_acquire) != head) {
+    if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+        CLOSED) {
+      CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
+      return CHANNEL_ERR_CLOSED;
+    }
+    spins++;
+    cpu_relax();
+  }
+  CHANNEL_STAT_ADD(sender->stats, full_spins, spins);
+
+  sender->reserved = slot;
+  sender->reserved_pos = head;
+  *slot_out = slot->data;
+  return CHANNEL_OK;
+};
+
+int spmc_commit(SenderSpmc *sender) {
+  if (!sender || !sender->reserved) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  // set slot for consumer
+  atomic_store_explicit(&sender->reserved->seq, sender->reserved_pos + 1,
+                        memory_order_release);
+  _channel_signal_poke(sender->signal);
+  sender->reserved = NULL;
+  CHANNEL_STAT_ADD(sender->stats, sends, 1);
+  CHANNEL_STAT_MAX(sender->stats,
+                   _channel_occupancy(sender->reserved_pos + 1,
+                                      atomic_load_explicit(
+                                          sender->tail, memory_order_relaxed)));
+  return CHANNEL_OK;
+};
+
+int spmc_peek(ReceiverSpmc *receiver, void **slot_out) {
+  if (!receiver || !slot_out) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (receiver->peeked) {
+    return CHANNEL_ERR_FULL;
+  }
+  if (atomic_load_explicit(&receiver->receiver_state, memory_order_acquire) ==
+      CLOSED) {
+    CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
+    return CHANNEL_ERR_CLOSED;
+  }
+  size_t tail =
+      atomic_fetch_add_explicit(receiver->tail, 1, memory_order_acq_rel);
+
+  Slot *slot = &receiver->buffer[tail % receiver->inner_c_cap];
+
+  size_t spins = 0;
+  while (atomic_load_explicit(&slot->seq, memory_order_acquire) != tail + 1) {
+    if (atomic_load_explicit(receiver->chan_state, memory_order_acquire) ==
+        CLOSED) {
+      CHANNEL_STAT_ADD(receiver->stats, closed_errors, 1);
+      return CHANNEL_ERR_CLOSED;
+    }
+    spins++;
+    cpu_relax();
+  }
+  CHANNEL_STAT_ADD(receiver->stats, empty_spins, spins);
+
+  receiver->peeked = slot;
+  receiver->peeked_pos = tail;
+  *slot_out = slot->data;
+  return CHANNEL_OK;
+};
+
+int spmc_release(ReceiverSpmc *receiver) {
+  if (!receiver || !receiver->peeked) {
+    return CHANNEL_ERR_NULL;
+  }
+
+  // set slot for next future cycle
+  atomic_store_explicit(&receiver->peeked->seq,
+                        receiver->peeked_pos + receiver->inner_c_cap,
+                        memory_order_release);
+  receiver->peeked = NULL;
+  CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
+  return CHANNEL_OK;
+};
 #endif
@@ -25,6 +25,11 @@
    SPSC - Single Producer Single Consumer Channel
    Lock-free channel for communication between a single producer thread
    and a single consumer thread.
+
+   Each side keeps a local copy of its own index and a cached copy of the
+   other side's index. The shared cursor of the other side is only read
+   when the ring looks full (producer) or empty (consumer), so in steady
+   state each operation touches a single shared cache line: its own cursor.
    ========================================================================== */
 
 /*-------------------------------------------*/
@@ -91,6 +96,23 @@ void spsc_close(ChannelSpsc *chan);
  */
 ChanState spsc_is_closed(const ChannelSpsc *chan);
 
+/**
+ * Attaches a ChannelSignal that the sender bumps after each publish and on
+ * close. Several channels may share one signal (see select.h).
+ * @param chan Pointer to the channel
+ * @param sig Signal to attach, NULL to detach
+ */
+void spsc_set_signal(ChannelSpsc *chan, ChannelSignal *sig);
+
+/**
+ * Copies the channel's telemetry counters into `out`.
+ * Only available when compiled with CHANNEL_TELEMETRY.
+ * @param chan Pointer to the channel
+ * @param out Receives the snapshot
+ * @return CHANNEL_OK, or CHANNEL_ERR_NULL if telemetry is compiled out
+ */
+int spsc_stats(const ChannelSpsc *chan, ChannelStats *out);
+
 typedef struct SenderSpsc_t SenderSpsc;
 
 typedef struct ReceiverSpsc_t ReceiverSpsc;
@@ -125,7 +147,8 @@ ReceiverSpsc *spsc_get_receiver(ChannelSpsc *chan);
  * @param sender Pointer to the sender handle
  * @param element Pointer to the element to send
  * @return SPSC_OK on success, SPSC_ERR_NULL if sender is NULL,
- *         SPSC_ERR_FULL if channel is full, SPSC_ERR_CLOSED if the channel is
+ *         SPSC_ERR_FULL if channel is full or a spsc_try_reserve slot is
+ *         pending (commit it first), SPSC_ERR_CLOSED if the channel is
  *         closed
  */
 int spsc_try_send(SenderSpsc *sender, const void *element);
@@ -136,10 +159,55 @@ int spsc_try_send(SenderSpsc *sender, const void *element);
  * @param receiver Pointer to the receiver handle
  * @param out Pointer to memory where the received element will be stored
  * @return SPSC_OK on success, SPSC_ERR_NULL if receiver is NULL,
- *         SPSC_ERR_EMPTY if channel is empty
+ *         SPSC_ERR_EMPTY if channel is empty or a spsc_peek slot is pending
+ *         (release it first)
  */
 int spsc_recv(ReceiverSpsc *receiver, void *out);
 
+/* --------------------------------------------------------------------------
+   Zero-copy operations
+   -------------------------------------------------------------------------- */
+
+/**
+ * Reserves the next slot of the channel for in-place writing.
+ * The slot becomes visible to the consumer only after spsc_commit.
+ * A sender holds at most one reservation at a time.
+ * @param sender Pointer to the sender handle
+ * @param slot Receives a pointer to elem_size writable bytes
+ * @return CHANNEL_OK on success, CHANNEL_ERR_NULL if sender or slot is NULL,
+ *         CHANNEL_ERR_FULL if channel is full or a reservation is pending,
+ *         CHANNEL_ERR_CLOSED if the channel is closed
+ */
+int spsc_try_reserve(SenderSpsc *sender, void **slot);
+
+/**
+ * Publishes the slot obtained with spsc_try_reserve.
+ * @param sender Pointer to the sender handle
+ * @return CHANNEL_OK on success, CHANNEL_ERR_NULL if sender is NULL or
+ *         nothing is reserved
+ */
+int spsc_commit(SenderSpsc *sender);
+
+/**
+ * Returns a pointer to the oldest element without copying it out.
+ * The element stays owned by the receiver until spsc_release.
+ * A receiver holds at most one peeked slot at a time.
+ * @param receiver Pointer to the receiver handle
+ * @param slot Receives a pointer to elem_size readable bytes
+ * @return CHANNEL_OK on success, CHANNEL_ERR_NULL if receiver or slot is
+ *         NULL, CHANNEL_ERR_EMPTY if channel is empty, CHANNEL_ERR_FULL if
+ *         a peek is pending
+ */
+int spsc_peek(ReceiverSpsc *receiver, void **slot);
+
+/**
+ * Hands the slot obtained with spsc_peek back to the producer.
+ * @param receiver Pointer to the receiver handle
+ * @return CHANNEL_OK on success, CHANNEL_ERR_NULL if receiver is NULL or
+ *         nothing is peeked
+ */
+int spsc_release(ReceiverSpsc *receiver);
+
 #endif
 
 #if (defined (SPSC_IMPLEMENTATION))
@@ -156,6 +224,10 @@ typedef struct ChannelSpsc_t {
   ConsumerCursor consumer;
 
   _Atomic ChanState state; // 0 -> Open | 1 -> Closed
+  _Atomic(ChannelSignal *) signal; // optional, see spsc_set_signal
+#if defined(CHANNEL_TELEMETRY)
+  ChannelTelemetry telemetry;
+#endif
 } ChannelSpsc;
 
 ChannelSpsc *channel_create_spsc(const size_t capacity,const size_t elem_size) {
@@ -178,18 +250,41 @@ ChannelSpsc *channel_create_spsc(const size_t capacity,const size_t elem_size) {
   chan->producer.head = 0;
   chan->consumer.tail = 0;
   chan->state = OPEN;
+  chan->signal = NULL;
+#if defined(CHANNEL_TELEMETRY)
+  _channel_telemetry_init(&chan->telemetry);
+#endif
 
   return chan;
 };
 
 void spsc_close(ChannelSpsc *chan) {
   atomic_store_explicit(&chan->state, CLOSED, memory_order_release);
+  _channel_signal_poke(&chan->signal);
 }
 
 ChanState spsc_is_closed(const ChannelSpsc *chan) {
   return atomic_load_explicit(&chan->state, memory_order_acquire);
 }
 
+void spsc_set_signal(ChannelSpsc *chan, ChannelSignal *sig) {
+  atomic_store_explicit(&chan->signal, sig, memory_order_release);
+}
+
+int spsc_stats(const ChannelSpsc *chan, ChannelStats *out) {
+#if defined(CHANNEL_TELEMETRY)
+  if (!chan || !out) {
+    return CHANNEL_ERR_NULL;
+  }
+  _channel_telemetry_snapshot(&chan->telemetry, out);
+  return CHANNEL_OK;
+#else
+  (void)chan;
+  (void)out;
+  return CHANNEL_ERR_NULL;
+#endif
+}
+
 void spsc_destroy(ChannelSpsc *chan) {
   if (!chan) {
     return;
@@ -207,6 +302,15 @@ typedef struct SenderSpsc_t {
   _Atomic size_t *head;
   _Atomic size_t *tail;
   _Atomic ChanState *chan_state;
+  _Atomic(ChannelSignal *) *signal;
+
+  size_t head_local; // producer owns head, no need to read it back
+  size_t tail_cache; // last observed consumer tail
+
+  uint8_t reserved; // 1 while a spsc_try_reserve slot is pending
+#if defined(CHANNEL_TELEMETRY)
+  ChannelStatsShard *stats;
+#endif
 } SenderSpsc;
 
 typedef struct ReceiverSpsc_t {
@@ -216,6 +320,14 @@ typedef struct ReceiverSpsc_t {
 
   _Atomic size_t *head;
   _Atomic size_t *tail;
+
+  size_t tail_local; // consumer owns tail, no need to read it back
+  size_t head_cache; // last observed producer head
+
+  uint8_t peeked; // 1 while a spsc_peek slot is pending
+#if defined(CHANNEL_TELEMETRY)
+  ChannelStatsShard *stats;
+#endif
 } ReceiverSpsc;
 
 SenderSpsc *spsc_get_sender(ChannelSpsc *chan) {
@@ -230,7 +342,16 @@ SenderSpsc *spsc_get_sender(ChannelSpsc *chan) {
   sender->tail = &chan->consumer.tail;
   sender->elem_size = chan->elem_size;
   sender->chan_state = &chan->state;
-
+  sender->signal = &chan->signal;
+  sender->head_local =
+      atomic_load_explicit(&chan->producer.head, memory_order_relaxed);
+  sender->tail_cache =
+      atomic_load_explicit(&chan->consumer.tail, memory_order_acquire);
+  sender->reserved = 0;
+
+#if defined(CHANNEL_TELEMETRY)
+  sender->stats = _channel_telemetry_shard(&chan->telemetry);
+#endif
   return sender;
 }
 
@@ -245,10 +366,40 @@ ReceiverSpsc *spsc_get_receiver(ChannelSpsc *chan) {
   receiver->tail = &chan->consumer.tail;
   receiver->head = &chan->producer.head;
   receiver->elem_size = chan->elem_size;
-
+  receiver->tail_local =
+      atomic_load_explicit(&chan->consumer.tail, memory_order_relaxed);
+  receiver->head_cache =
+      atomic_load_explicit(&chan->producer.head, memory_order_acquire);
+  receiver->peeked = 0;
+
+#if defined(CHANNEL_TELEMETRY)
+  receiver->stats = _channel_telemetry_shard(&chan->telemetry);
+#endif
   return receiver;
 }
 
+// 1 if there is room for one more element. Refreshes the cached tail only
+// when the ring looks full.
+static inline int _spsc_has_room(SenderSpsc *sender) {
+  if (sender->head_local - sender->tail_cache < sender->inner_c_cap) {
+    return 1;
+  }
+  sender->tail_cache =
+      atomic_load_explicit(sender->tail, memory_order_acquire);
+  return sender->head_local - sender->tail_cache < sender->inner_c_cap;
+}
+
+// 1 if there is at least one element. Refreshes the cached head only when
+// the ring looks empty.
+static inline int _spsc_has_data(ReceiverSpsc *receiver) {
+  if (receiver->tail_local != receiver->head_cache) {
+    return 1;
+  }
+  receiver->head_cache =
+      atomic_load_explicit(receiver->head, memory_order_acquire);
+  return receiver->tail_local != receiver->head_cache;
+}
+
 int spsc_try_send(SenderSpsc *sender, const void *element) {
   if (!sender) {
     return CHANNEL_ERR_NULL;
@@ -257,22 +408,32 @@ int spsc_try_send(SenderSpsc *sender, const void *element) {
       atomic_load_explicit(sender->chan_state, memory_order_acquire);
 
   if (state == CLOSED) {
+    CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
     return CHANNEL_ERR_CLOSED;
   }
+  // the next slot belongs to the pending reservation
+  if (sender->reserved) {
+    return CHANNEL_ERR_FULL;
+  }
 
-  size_t head = atomic_load_explicit(sender->head, memory_order_relaxed);
-  size_t tail = atomic_load_explicit(sender->tail, memory_order_acquire);
-  if (head - tail == sender->inner_c_cap) {
+  if (!_spsc_has_room(sender)) {
+    CHANNEL_STAT_ADD(sender->stats, full_spins, 1);
     return CHANNEL_ERR_FULL;
   }
 
-  size_t index = head % sender->inner_c_cap;
+  size_t index = sender->head_local % sender->inner_c_cap;
 
   memcpy(sender->buffer + (index * sender->elem_size), element,
          sender->elem_size);
 
-  atomic_fetch_add_explicit(sender->head, 1, memory_order_release);
+  sender->head_local++;
+  atomic_store_explicit(sender->head, sender->head_local,
+                        memory_order_release);
+  _channel_signal_poke(sender->signal);
 
+  CHANNEL_STAT_ADD(sender->stats, sends, 1);
+  CHANNEL_STAT_MAX(sender->stats,
+                   sender->head_local - sender->tail_cache);
   return CHANNEL_OK;
 }
 
@@ -280,17 +441,95 @@ int spsc_recv(ReceiverSpsc *receiver, void *out) {
   if (!receiver) {
     return CHANNEL_ERR_NULL;
   }
-  size_t tail = atomic_load_explicit(receiver->tail, memory_order_relaxed);
-  size_t head = atomic_load_explicit(receiver->head, memory_order_acquire);
-  if (tail == head) {
+  // the oldest element is the peeked one, spsc_release consumes it
+  if (receiver->peeked) {
+    return CHANNEL_ERR_EMPTY;
+  }
+  if (!_spsc_has_data(receiver)) {
+    CHANNEL_STAT_ADD(receiver->stats, empty_spins, 1);
     return CHANNEL_ERR_EMPTY;
   }
 
-  size_t index = tail % receiver->inner_c_cap;
+  size_t index = receiver->tail_local % receiver->inner_c_cap;
 
   memcpy(out, receiver->buffer + (index * receiver->elem_size),
          receiver->elem_size);
-  atomic_fetch_add_explicit(receiver->tail, 1, memory_order_relaxed);
+
+  // release: the producer may overwrite the slot only after the copy
+  receiver->tail_local++;
+  atomic_store_explicit(receiver->tail, receiver->tail_local,
+                        memory_order_release);
+  CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
+  return CHANNEL_OK;
+}
+
+int spsc_try_reserve(SenderSpsc *sender, void **slot) {
+  if (!sender || !slot) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (atomic_load_explicit(sender->chan_state, memory_order_acquire) ==
+      CLOSED) {
+    CHANNEL_STAT_ADD(sender->stats, closed_errors, 1);
+    return CHANNEL_ERR_CLOSED;
+  }
+  if (sender->reserved) {
+    return CHANNEL_ERR_FULL;
+  }
+
+  if (!_spsc_has_room(sender)) {
+    CHANNEL_STAT_ADD(sender->stats, full_spins, 1);
+    return CHANNEL_ERR_FULL;
+  }
+
+  *slot = sender->buffer +
+          ((sender->head_local % sender->inner_c_cap) * sender->elem_size);
+  sender->reserved = 1;
+  return CHANNEL_OK;
+}
+
+int spsc_commit(SenderSpsc *sender) {
+  if (!sender || !sender->reserved) {
+    return CHANNEL_ERR_NULL;
+  }
+  sender->reserved = 0;
+  sender->head_local++;
+  atomic_store_explicit(sender->head, sender->head_local,
+                        memory_order_release);
+  _channel_signal_poke(sender->signal);
+  CHANNEL_STAT_ADD(sender->stats, sends, 1);
+  CHANNEL_STAT_MAX(sender->stats,
+                   sender->head_local - sender->tail_cache);
+  return CHANNEL_OK;
+}
+
+int spsc_peek(ReceiverSpsc *receiver, void **slot) {
+  if (!receiver || !slot) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (receiver->peeked) {
+    return CHANNEL_ERR_FULL;
+  }
+  if (!_spsc_has_data(receiver)) {
+    CHANNEL_STAT_ADD(receiver->stats, empty_spins, 1);
+    return CHANNEL_ERR_EMPTY;
+  }
+
+  *slot = receiver->buffer +
+          ((receiver->tail_local % receiver->inner_c_cap) * receiver->elem_size);
+  receiver->peeked = 1;
+  return CHANNEL_OK;
+}
+
+int spsc_release(ReceiverSpsc *receiver) {
+  if (!receiver || !receiver->peeked) {
+    return CHANNEL_ERR_NULL;
+  }
+  receiver->peeked = 0;
+  // release: the producer may overwrite the slot only after we are done
+  receiver->tail_local++;
+  atomic_store_explicit(receiver->tail, receiver->tail_local,
+                        memory_order_release);
+  CHANNEL_STAT_ADD(receiver->stats, recvs, 1);
   return CHANNEL_OK;
 }
 #endif
@@ -0,0 +1,321 @@
+// Copyright 2025 Seaker <seakerone@proton.me>
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+------------------------------------------------------------------------------
+typed.h — Compile-time typed channels
+
+The regular channels are type-erased: every send/recv copies elem_size
+bytes with a runtime size, so the compiler can neither specialize the copy
+nor check the element type at the call site.
+
+This header generates a typed ring for one element type:
+
+    DEFINE_SPSC(EventQ, SAE_Event)
+    DEFINE_MPMC(JobQ, Job)
+
+Each macro emits a struct and a set of static inline functions prefixed
+with the given name. sizeof(T) is a constant, elements are stored inline
+(no per-slot allocation) and capacity is rounded up to a power of two, so
+indexing is a mask and small element copies become register moves.
+
+------------------------------------------------------------------------------
+GENERATED API (for DEFINE_SPSC(Name, T) / DEFINE_MPMC(Name, T))
+
+    int       Name_init(Name *q, size_t capacity);
+    void      Name_destroy(Name *q);
+    void      Name_close(Name *q);
+    ChanState Name_is_closed(Name *q);
+
+    int       Name_try_send(Name *q, const T *value);  // never waits
+    int       Name_try_recv(Name *q, T *out);          // never waits
+    int       Name_send(Name *q, const T *value);      // spins while full
+    int       Name_recv(Name *q, T *out);              // spins while empty
+
+Return codes are the usual CHANNEL_OK / CHANNEL_ERR_* values. Blocking
+calls return CHANNEL_ERR_CLOSED once the channel is closed (recv only
+after it is drained).
+
+------------------------------------------------------------------------------
+DIFFERENCES WITH THE TYPE-ERASED CHANNELS
+
+- No sender/receiver handles: the channel struct is used directly and can
+  live inside another struct or on the stack (init/destroy only manage
+  the element buffer).
+- SPSC: exactly one thread sends and one thread receives. Both sides keep
+  a cached copy of the opposite index next to their own.
+- MPMC: any number of senders/receivers, positions are claimed with CAS so
+  try_send/try_recv never leave a claimed slot behind. Use it for MPSC
+  and SPMC as well.
+- Slots are not padded to a cache line; elements are packed.
+
+------------------------------------------------------------------------------
+USAGE
+
+This header only depends on channels.h (return codes, ChanState,
+cpu_relax) and needs no IMPLEMENTATION define:
+
+    #include "channels.h"
+    #include "typed.h"
+
+    DEFINE_SPSC(EventQ, SAE_Event)
+
+    EventQ q;
+    EventQ_init(&q, 1024);
+    EventQ_try_send(&q, &ev);
+
+------------------------------------------------------------------------------
+*/
+#ifndef TYPED_CHANNEL_H
+#define TYPED_CHANNEL_H
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Smallest power of two >= n (and >= 2).
+static inline size_t _typed_chan_pow2(size_t n) {
+  size_t cap = 2;
+  while (cap < n) {
+    cap <<= 1;
+  }
+  return cap;
+}
+
+/*-----------------------------------------------------------------------------
+  DEFINE_SPSC(Name, T)
+  Single-producer / single-consumer ring of T.
+-----------------------------------------------------------------------------*/
+#define DEFINE_SPSC(Name, T)                                                   \
+  typedef struct Name##_t {                                                    \
+    /* producer line */                                                        \
+    alignas(CACHELINE_SIZE) _Atomic size_t head;                               \
+    size_t tail_cache; /* last observed consumer tail */                       \
+    /* consumer line */                                                        \
+    alignas(CACHELINE_SIZE) _Atomic size_t tail;                               \
+    size_t head_cache; /* last observed producer head */                       \
+    /* read-only after init */                                                 \
+    alignas(CACHELINE_SIZE) T *buffer;                                         \
+    size_t mask;                                                               \
+    _Atomic ChanState state;                                                   \
+  } Name;                                                                      \
+                                                                               \
+  static inline int Name##_init(Name *q, size_t capacity) {                    \
+    if (!q || capacity == 0) {                                                 \
+      return CHANNEL_ERR_NULL;                                                 \
+    }                                                                          \
+    size_t cap = _typed_chan_pow2(capacity);                                   \
+    q->buffer = malloc(cap * sizeof(T));                                       \
+    if (!q->buffer) {                                                          \
+      return CHANNEL_ERR_NULL;                                                 \
+    }                                                                          \
+    q->mask = cap - 1;                                                         \
+    atomic_init(&q->head, 0);                                                  \
+    atomic_init(&q->tail, 0);                                                  \
+    q->tail_cache = 0;                                                         \
+    q->head_cache = 0;                                                         \
+    atomic_init(&q->state, OPEN);                                              \
+    return CHANNEL_OK;                                                         \
+  }                                                                            \
+                                                                               \
+  static inline void Name##_destroy(Name *q) {                                 \
+    free(q->buffer);                                                           \
+    q->buffer = NULL;                                                          \
+  }                                                                            \
+                                                                               \
+  static inline void Name##_close(Name *q) {                                   \
+    atomic_store_explicit(&q->state, CLOSED, memory_order_release);            \
+  }                                                                            \
+                                                                               \
+  static inline ChanState Name##_is_closed(Name *q) {                          \
+    return atomic_load_explicit(&q->state, memory_order_acquire);              \
+  }                                                                            \
+                                                                               \
+  static inline int Name##_try_send(Name *q, const T *value) {                 \
+    if (atomic_load_explicit(&q->state, memory_order_relaxed) == CLOSED) {     \
+      return CHANNEL_ERR_CLOSED;                                               \
+    }                                                                          \
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);        \
+    if (head - q->tail_cache > q->mask) {                                      \
+      q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);    \
+      if (head - q->tail_cache > q->mask) {                                    \
+        return CHANNEL_ERR_FULL;                                               \
+      }                                                                        \
+    }                                                                          \
+    q->buffer[head & q->mask] = *value;                                        \
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);           \
+    return CHANNEL_OK;                                                         \
+  }                                                                            \
+                                                                               \
+  static inline int Name##_try_recv(Name *q, T *out) {                         \
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);        \
+    if (tail == q->head_cache) {                                               \
+      q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);    \
+      if (tail == q->head_cache) {                                             \
+        if (atomic_load_explicit(&q->state, memory_order_acquire) == CLOSED && \
+            atomic_load_explicit(&q->head, memory_order_acquire) == tail) {    \
+          return CHANNEL_ERR_CLOSED;                                           \
+        }                                                                      \
+        return CHANNEL_ERR_EMPTY;                                              \
+      }                                                                        \
+    }                                                                          \
+    *out = q->buffer[tail & q->mask];                                          \
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);           \
+    return CHANNEL_OK;                                                         \
+  }                                                                            \
+                                                                               \
+  static inline int Name##_send(Name *q, const T *value) {                     \
+    int res;                                                                   \
+    while ((res = Name##_try_send(q, value)) == CHANNEL_ERR_FULL) {            \
+      cpu_relax();                                                             \
+    }                                                                          \
+    return res;                                                                \
+  }                                                                            \
+                                                                               \
+  static inline int Name##_recv(Name *q, T *out) {                             \
+    int res;                                                                   \
+    while ((res = Name##_try_recv(q, out)) == CHANNEL_ERR_EMPTY) {             \
+      cpu_relax();                                                             \
+    }                                                                          \
+    return res;                                                                \
+  }
+
+/*-----------------------------------------------------------------------------
+  DEFINE_MPMC(Name, T)
+  Multi-producer / multi-consumer ring of T (per-slot sequence numbers).
+-----------------------------------------------------------------------------*/
+#define DEFINE_MPMC(Name, T)                                                   \
+  typedef struct Name##_cell_t {                                               \
+    _Atomic size_t seq;                                                        \
+    T value;                                                                   \
+  } Name##_cell;                                                               \
+                                                                               \
+  typedef struct Name##_t {                                                    \
+    alignas(CACHELINE_SIZE) _Atomic size_t head;                               \
+    alignas(CACHELINE_SIZE) _Atomic size_t tail;                               \
+    alignas(CACHELINE_SIZE) Name##_cell *cells;                                \
+    size_t mask;                                                               \
+    _Atomic ChanState state;                                                   \
+  } Name;                                                                      \
+                                                                               \
+  static inline int Name##_init(Name *q, size_t capacity) {                    \
+    if (!q || capacity == 0) {                                                 \
+      return CHANNEL_ERR_NULL;                                                 \
+    }                                                                          \
+    size_t cap = _typed_chan_pow2(capacity);                                   \
+    q->cells = malloc(cap * sizeof(Name##_cell));                              \
+    if (!q->cells) {                                                           \
+      return CHANNEL_ERR_NULL;                                                 \
+    }                                                                          \
+    for (size_t x = 0; x < cap; x++) {                                         \
+      atomic_init(&q->cells[x].seq, x);                                        \
+    }                                                                          \
+    q->mask = cap - 1;                                                         \
+    atomic_init(&q->head, 0);                                                  \
+    atomic_init(&q->tail, 0);                                                  \
+    atomic_init(&q->state, OPEN);                                              \
+    return CHANNEL_OK;                                                         \
+  }                                                                            \
+                                                                               \
+  static inline void Name##_destroy(Name *q) {                                 \
+    free(q->cells);                                                            \
+    q->cells = NULL;                                                           \
+  }                                                                            \
+                                                                               \
+  static inline void Name##_close(Name *q) {                                   \
+    atomic_store_explicit(&q->state, CLOSED, memory_order_release);            \
+  }                                                                            \
+                                                                               \
+  static inline ChanState Name##_is_closed(Name *q) {                          \
+    return atomic_load_explicit(&q->state, memory_order_acquire);              \
+  }                                                                            \
+                                                                               \
+  static inline int Name##_try_send(Name *q, const T *value) {                 \
+    if (atomic_load_explicit(&q->state, memory_order_relaxed) == CLOSED) {     \
+      return CHANNEL_ERR_CLOSED;                                               \
+    }                                                                          \
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);        \
+    for (;;) {                                                                 \
+      Name##_cell *cell = &q->cells[head & q->mask];                           \
+      size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);     \
+      intptr_t diff = (intptr_t)seq - (intptr_t)head;                          \
+      if (diff == 0) {                                                         \
+        if (atomic_compare_exchange_weak_explicit(                             \
+                &q->head, &head, head + 1, memory_order_relaxed,               \
+                memory_order_relaxed)) {                                       \
+          cell->value = *value;                                                \
+          atomic_store_explicit(&cell->seq, head + 1, memory_order_release);   \
+          return CHANNEL_OK;                                                   \
+        }                                                                      \
+      } else if (diff < 0) {                                                   \
+        return CHANNEL_ERR_FULL;                                               \
+      } else {                                                                 \
+        head = atomic_load_explicit(&q->head, memory_order_relaxed);           \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static inline int Name##_try_recv(Name *q, T *out) {                         \
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);        \
+    for (;;) {                                                                 \
+      Name##_cell *cell = &q->cells[tail & q->mask];                           \
+      size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);     \
+      intptr_t diff = (intptr_t)seq - (intptr_t)(tail + 1);                    \
+      if (diff == 0) {                                                         \
+        if (atomic_compare_exchange_weak_explicit(                             \
+                &q->tail, &tail, tail + 1, memory_order_relaxed,               \
+                memory_order_relaxed)) {                                       \
+          *out = cell->value;                                                  \
+          atomic_store_explicit(&cell->seq, tail + q->mask + 1,                \
+                                memory_order_release);                         \
+          return CHANNEL_OK;                                                   \
+        }                                                                      \
+      } else if (diff < 0) {                                                   \
+        if (atomic_load_explicit(&q->state, memory_order_acquire) == CLOSED && \
+            atomic_load_explicit(&cell->seq, memory_order_acquire) !=          \
+                tail + 1) {                                                    \
+          return CHANNEL_ERR_CLOSED;                                           \
+        }                                                                      \
+        return CHANNEL_ERR_EMPTY;                                              \
+      } else {                                                                 \
+        tail = atomic_load_explicit(&q->tail, memory_order_relaxed);           \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static inline int Name##_send(Name *q, const T *value) {                     \
+    int res;                                                                   \
+    while ((res = Name##_try_send(q, value)) == CHANNEL_ERR_FULL) {            \
+      cpu_relax();                                                             \
+    }                                                                          \
+    return res;                                                                \
+  }                                                                            \
+                                                                               \
+  static inline int Name##_recv(Name *q, T *out) {                             \
+    int res;                                                                   \
+    while ((res = Name##_try_recv(q, out)) == CHANNEL_ERR_EMPTY) {             \
+      cpu_relax();                                                             \
+    }                                                                          \
+    return res;                                                                \
+  }
+
+#endif
@@ -0,0 +1,777 @@
+// Copyright 2025 Seaker <seakerone@proton.me>
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+------------------------------------------------------------------------------
+unbounded.h — Unbounded segmented Multi-Producer Multi-Consumer channel
+
+This channel supports:
+- multiple producers
+- multiple consumers (a single consumer works the same way: MPSC)
+- NO fixed capacity: storage grows with the actual load
+- busy-wait synchronization (no blocking, no syscalls)
+
+Every other channel is a ring whose capacity is chosen at creation time,
+so callers size it for the worst case. This one is a linked list of
+fixed-size segments. Producers append segments when the tail segment is
+full, consumers hand a segment back once every slot of it was read.
+Retired segments go to a small lock-free pool and are reused before any
+new allocation, so steady-state traffic does not touch malloc.
+
+------------------------------------------------------------------------------
+PROPERTIES
+
+- Lock-free for producers and consumers
+- Producers never wait for room (only for a segment switch in progress)
+- Memory proportional to the number of queued elements, plus the pool
+- Creation allocates a single segment
+- Cross-platform (x86, ARM, RISC-V)
+
+------------------------------------------------------------------------------
+MEMORY LAYOUT
+
+Positions are numbered in laps of UNBOUNDED_SEGMENT_CAPACITY + 1. Offset
+UNBOUNDED_SEGMENT_CAPACITY of each lap is never a slot: a cursor sitting
+there means "the thread that took the last slot is installing the next
+segment", everybody else waits a few cycles.
+
+    head.index / head.segment   next position to read and its segment
+    tail.index / tail.segment   next position to write and its segment
+
+A thread only dereferences a segment after winning a position inside it
+(CAS on the index), which keeps the segment alive until that slot is
+read. The last reader of a segment retires it (slots carry WRITE, READ
+and DESTROY bits so the retirement can be finished by a late reader).
+
+------------------------------------------------------------------------------
+LIFETIME
+
+1. channel_create_unbounded()
+2. unbounded_get_sender() (N times)
+3. unbounded_get_receiver() (N times)
+4. unbounded_send() / unbounded_send_batch() / unbounded_recv()
+5. unbounded_close()
+6. unbounded_close_sender() / unbounded_close_receiver()
+7. unbounded_destroy()
+
+Senders and receivers must be freed by the user.
+
+------------------------------------------------------------------------------
+WARNING
+
+Unbounded means unbounded: a consumer that falls behind is never pushed
+back on, the queue just grows. Use a bounded channel when backpressure is
+what you want.
+------------------------------------------------------------------------------
+*/
+#ifndef UNBOUNDED_CHANNEL_H
+#define UNBOUNDED_CHANNEL_H
+
+/*-------------------------------------------*/
+/*      Platform-dependent cpu_relax()       */
+/*-------------------------------------------*/
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+#define cpu_relax() _mm_pause()
+/*-------------------------------------------*/
+#elif defined(__aarch64__) || defined(__arm__)
+
+#define cpu_relax() __asm__ __volatile__("yield")
+/*-------------------------------------------*/
+#elif defined(__riscv)
+
+#define cpu_relax() __asm__ __volatile__("pause")
+/*-------------------------------------------*/
+#else
+#define cpu_relax() ((void)0)
+#endif
+/*-------------------------------------------*/
+
+#include <stddef.h>
+
+// Slots per segment.
+#ifndef UNBOUNDED_SEGMENT_CAPACITY
+#define UNBOUNDED_SEGMENT_CAPACITY 31
+#endif
+
+// Retired segments kept for reuse, extra ones are freed.
+#ifndef UNBOUNDED_POOL_CAPACITY
+#define UNBOUNDED_POOL_CAPACITY 64
+#endif
+
+typedef struct ChannelUnbounded_t ChannelUnbounded;
+typedef enum ChanState_t ChanState;
+
+/*-----------------------------------------------------------------------------
+  channel_create_unbounded
+  Allocates and initializes a new unbounded channel.
+
+  elem_size : size in bytes of each element
+
+  Returns a pointer to ChannelUnbounded on success, NULL on allocation
+  failure.
+
+  Notes:
+    - Only the first segment is allocated here.
+-----------------------------------------------------------------------------*/
+ChannelUnbounded *channel_create_unbounded(const size_t elem_size);
+
+/*-----------------------------------------------------------------------------
+  unbounded_close
+  Marks the channel as closed.
+
+  chan : pointer to the channel to close
+
+  Notes:
+    - After closing, unbounded_send will return CHANNEL_ERR_CLOSED.
+    - Consumers may continue to drain the channel until empty.
+-----------------------------------------------------------------------------*/
+void unbounded_close(ChannelUnbounded *chan);
+
+/*-----------------------------------------------------------------------------
+  unbounded_is_closed
+  Checks whether the channel has been closed.
+
+  chan : pointer to the channel
+
+  Returns:
+    - OPEN   if the channel is still open
+    - CLOSED if the channel has been closed
+-----------------------------------------------------------------------------*/
+ChanState unbounded_is_closed(const ChannelUnbounded *chan);
+
+/*-----------------------------------------------------------------------------
+  unbounded_set_signal
+  Attaches a ChannelSignal that senders bump after each publish and on close.
+
+  chan : pointer to the channel
+  sig  : signal to attach, NULL to detach
+
+  Notes:
+    - Several channels may share one signal (see select.h).
+-----------------------------------------------------------------------------*/
+void unbounded_set_signal(ChannelUnbounded *chan, ChannelSignal *sig);
+
+/*-----------------------------------------------------------------------------
+  unbounded_destroy
+  Frees every segment (queued, pooled) and the channel itself.
+
+  chan : pointer to the channel
+
+  Notes:
+    - Blocks until all senders and receivers are closed.
+    - Elements still queued are dropped.
+    - After this call, the channel pointer becomes invalid.
+-----------------------------------------------------------------------------*/
+void unbounded_destroy(ChannelUnbounded *chan);
+
+typedef struct SenderUnbounded_t SenderUnbounded;
+typedef struct ReceiverUnbounded_t ReceiverUnbounded;
+
+/*-----------------------------------------------------------------------------
+  unbounded_get_sender / unbounded_get_receiver
+  Allocate and return a producer / consumer handle for the given channel.
+
+  chan : pointer to a valid ChannelUnbounded
+
+  Returns a pointer to the handle on success, NULL on failure.
+
+  Notes:
+    - Any number of senders and receivers can be attached.
+    - Each handle must be closed before freeing.
+-----------------------------------------------------------------------------*/
+SenderUnbounded *unbounded_get_sender(ChannelUnbounded *chan);
+ReceiverUnbounded *unbounded_get_receiver(ChannelUnbounded *chan);
+
+/*-----------------------------------------------------------------------------
+  unbounded_close_sender / unbounded_close_receiver
+  Mark a handle as closed and decrement the channel's producer / consumer
+  count.
+-----------------------------------------------------------------------------*/
+void unbounded_close_sender(SenderUnbounded *sender);
+void unbounded_close_receiver(ReceiverUnbounded *receiver);
+
+/*-----------------------------------------------------------------------------
+  unbounded_send
+  Appends an element to the channel.
+
+  sender  : pointer to a valid SenderUnbounded
+  element : pointer to the element data to send
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if sender is NULL
+    - CHANNEL_ERR_FULL    if a new segment was needed and allocation failed
+    - CHANNEL_ERR_CLOSED  if channel is closed
+
+  Notes:
+    - Never waits for consumers.
+    - Copies elem_size bytes from element into the tail segment.
+-----------------------------------------------------------------------------*/
+int unbounded_send(SenderUnbounded *sender, const void *element);
+
+/*-----------------------------------------------------------------------------
+  unbounded_send_batch
+  Appends `count` contiguous elements, claiming a run of positions at once.
+
+  sender   : pointer to a valid SenderUnbounded
+  elements : pointer to count * elem_size bytes
+  count    : number of elements
+  sent     : optional, receives the number of elements published
+
+  Returns:
+    - CHANNEL_OK          on success (also for count == 0), *sent == count
+    - CHANNEL_ERR_NULL    if sender or elements is NULL
+    - CHANNEL_ERR_FULL    if a new segment was needed and allocation failed,
+                          elements[0, *sent) were published
+    - CHANNEL_ERR_CLOSED  if channel is closed (nothing is sent)
+
+  Notes:
+    - One tail CAS per segment the batch touches instead of one per
+      element. Elements of one run are consecutive, another producer may
+      slip in between two runs.
+    - The attached signal (if any) is bumped once, after the last element
+      published.
+-----------------------------------------------------------------------------*/
+int unbounded_send_batch(SenderUnbounded *sender, const void *elements,
+                         size_t count, size_t *sent);
+
+/*-----------------------------------------------------------------------------
+  unbounded_recv
+  Receives an element from the channel.
+
+  receiver : pointer to a valid ReceiverUnbounded
+  out      : pointer to memory where the element will be copied
+
+  Returns:
+    - CHANNEL_OK          on success
+    - CHANNEL_ERR_NULL    if receiver is NULL
+    - CHANNEL_ERR_CLOSED  if receiver is closed, or the channel is closed
+                          and drained
+
+  Notes:
+    - Busy-waits until an element becomes available or the channel closes.
+-----------------------------------------------------------------------------*/
+int unbounded_recv(ReceiverUnbounded *receiver, void *out);
+
+/*-----------------------------------------------------------------------------
+  unbounded_try_recv
+  Non-blocking unbounded_recv.
+
+  Returns CHANNEL_ERR_EMPTY instead of waiting when no element is queued,
+  CHANNEL_ERR_CLOSED once the channel is closed and drained.
+-----------------------------------------------------------------------------*/
+int unbounded_try_recv(ReceiverUnbounded *receiver, void *out);
+
+#endif
+
+#if (defined(UNBOUNDED_IMPLEMENTATION))
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UNBOUNDED_LAP (UNBOUNDED_SEGMENT_CAPACITY + 1)
+
+/* slot state bits */
+#define UNBOUNDED_SLOT_WRITE 1   // element is written
+#define UNBOUNDED_SLOT_READ 2    // element was read
+#define UNBOUNDED_SLOT_DESTROY 4 // segment retirement waits on this reader
+
+typedef struct UnboundedSegment_t {
+  _Atomic(struct UnboundedSegment_t *) next;
+  _Atomic size_t state[UNBOUNDED_SEGMENT_CAPACITY];
+  uint8_t *data; // UNBOUNDED_SEGMENT_CAPACITY * elem_size, right after this
+} UnboundedSegment;
+
+typedef struct UnboundedCursor_t {
+  alignas(CACHELINE_SIZE) _Atomic size_t index;
+  _Atomic(UnboundedSegment *) segment;
+  char _pad[CACHELINE_SIZE - sizeof(size_t) - sizeof(void *)];
+} UnboundedCursor;
+
+// Bounded pool of retired segments (per-cell sequence numbers, like Slot).
+typedef struct UnboundedPoolCell_t {
+  _Atomic size_t seq;
+  UnboundedSegment *segment;
+} UnboundedPoolCell;
+
+typedef struct ChannelUnbounded_t {
+  UnboundedCursor head; // consumers
+  UnboundedCursor tail; // producers
+  size_t elem_size;     // sizeof(T)
+
+  UnboundedPoolCell pool[UNBOUNDED_POOL_CAPACITY];
+  ProducerCursor pool_head;
+  ConsumerCursor pool_tail;
+
+  _Atomic size_t cons_cont; // Number of active consumers
+  _Atomic size_t prod_cont; // Number of active producers
+  _Atomic ChanState state;  // 0 -> Open | 1 -> Closed
+  _Atomic(ChannelSignal *) signal; // optional, see unbounded_set_signal
+} ChannelUnbounded;
+
+typedef struct SenderUnbounded_t {
+  ChannelUnbounded *chan;
+  _Atomic ChanState sender_state;
+} SenderUnbounded;
+
+typedef struct ReceiverUnbounded_t {
+  ChannelUnbounded *chan;
+  _Atomic ChanState receiver_state;
+} ReceiverUnbounded;
+
+static UnboundedSegment *_unbounded_segment_alloc(size_t elem_size) {
+  UnboundedSegment *seg = malloc(sizeof(UnboundedSegment) +
+                                 UNBOUNDED_SEGMENT_CAPACITY * elem_size);
+  if (!seg) {
+    return NULL;
+  }
+  seg->data = (uint8_t *)(seg + 1);
+  atomic_init(&seg->next, NULL);
+  for (size_t x = 0; x < UNBOUNDED_SEGMENT_CAPACITY; x++) {
+    atomic_init(&seg->state[x], 0);
+  }
+  return seg;
+}
+
+// Takes a retired segment from the pool, or allocates a new one.
+static UnboundedSegment *_unbounded_segment_get(ChannelUnbounded *chan) {
+  size_t pos = atomic_load_explicit(&chan->pool_tail.tail, memory_order_relaxed);
+  for (;;) {
+    UnboundedPoolCell *cell = &chan->pool[pos % UNBOUNDED_POOL_CAPACITY];
+    size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+    if (diff == 0) {
+      if (atomic_compare_exchange_weak_explicit(
+              &chan->pool_tail.tail, &pos, pos + 1, memory_order_relaxed,
+              memory_order_relaxed)) {
+        UnboundedSegment *seg = cell->segment;
+        atomic_store_explicit(&cell->seq, pos + UNBOUNDED_POOL_CAPACITY,
+                              memory_order_release);
+
+        atomic_store_explicit(&seg->next, NULL, memory_order_relaxed);
+        for (size_t x = 0; x < UNBOUNDED_SEGMENT_CAPACITY; x++) {
+          atomic_store_explicit(&seg->state[x], 0, memory_order_relaxed);
+        }
+        return seg;
+      }
+    } else if (diff < 0) {
+      return _unbounded_segment_alloc(chan->elem_size); // pool is empty
+    } else {
+      pos = atomic_load_explicit(&chan->pool_tail.tail, memory_order_relaxed);
+    }
+  }
+}
+
+// Returns a segment nobody references anymore to the pool (or frees it).
+static void _unbounded_segment_put(ChannelUnbounded *chan,
+                                   UnboundedSegment *seg) {
+  size_t pos = atomic_load_explicit(&chan->pool_head.head, memory_order_relaxed);
+  for (;;) {
+    UnboundedPoolCell *cell = &chan->pool[pos % UNBOUNDED_POOL_CAPACITY];
+    size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+    if (diff == 0) {
+      if (atomic_compare_exchange_weak_explicit(
+              &chan->pool_head.head, &pos, pos + 1, memory_order_relaxed,
+              memory_order_relaxed)) {
+        cell->segment = seg;
+        atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+        return;
+      }
+    } else if (diff < 0) {
+      free(seg); // pool is full
+      return;
+    } else {
+      pos = atomic_load_explicit(&chan->pool_head.head, memory_order_relaxed);
+    }
+  }
+}
+
+// Retires `seg` once slots [start, CAPACITY - 1) are read. If one of them
+// is still being read, its reader finishes the retirement instead.
+// The last slot is never checked: its reader is the one starting at 0.
+static void _unbounded_segment_retire(ChannelUnbounded *chan,
+                                      UnboundedSegment *seg, size_t start) {
+  for (size_t x = start; x < UNBOUNDED_SEGMENT_CAPACITY - 1; x++) {
+    _Atomic size_t *state = &seg->state[x];
+    if ((atomic_load_explicit(state, memory_order_acquire) &
+         UNBOUNDED_SLOT_READ) == 0 &&
+        (atomic_fetch_or_explicit(state, UNBOUNDED_SLOT_DESTROY,
+                                  memory_order_acq_rel) &
+         UNBOUNDED_SLOT_READ) == 0) {
+      return;
+    }
+  }
+  _unbounded_segment_put(chan, seg);
+}
+
+ChannelUnbounded *channel_create_unbounded(const size_t elem_size) {
+  ChannelUnbounded *chan = aligned_alloc(CACHELINE_SIZE, sizeof(ChannelUnbounded));
+  if (!chan) {
+    return NULL;
+  }
+
+  UnboundedSegment *first = _unbounded_segment_alloc(elem_size);
+  if (!first) {
+    free(chan);
+    return NULL;
+  }
+
+  chan->elem_size = elem_size;
+  atomic_init(&chan->head.index, 0);
+  atomic_init(&chan->head.segment, first);
+  atomic_init(&chan->tail.index, 0);
+  atomic_init(&chan->tail.segment, first);
+
+  for (size_t x = 0; x < UNBOUNDED_POOL_CAPACITY; x++) {
+    atomic_init(&chan->pool[x].seq, x);
+    chan->pool[x].segment = NULL;
+  }
+  atomic_init(&chan->pool_head.head, 0);
+  atomic_init(&chan->pool_tail.tail, 0);
+
+  atomic_init(&chan->cons_cont, 0);
+  atomic_init(&chan->prod_cont, 0);
+  atomic_init(&chan->state, OPEN);
+  atomic_init(&chan->signal, NULL);
+  return chan;
+}
+
+void unbounded_close(ChannelUnbounded *chan) {
+  atomic_store_explicit(&chan->state, CLOSED, memory_order_release);
+  _channel_signal_poke(&chan->signal);
+}
+
+ChanState unbounded_is_closed(const ChannelUnbounded *chan) {
+  return atomic_load_explicit(&chan->state, memory_order_acquire);
+}
+
+void unbounded_set_signal(ChannelUnbounded *chan, ChannelSignal *sig) {
+  atomic_store_explicit(&chan->signal, sig, memory_order_release);
+}
+
+void unbounded_destroy(ChannelUnbounded *chan) {
+  if (!chan) {
+    return;
+  }
+
+  size_t cons_cont;
+  size_t prod_cont;
+
+  unbounded_close(chan);
+  do {
+    cons_cont = atomic_load_explicit(&chan->cons_cont, memory_order_acquire);
+    prod_cont = atomic_load_explicit(&chan->prod_cont, memory_order_acquire);
+  } while (cons_cont != 0 || prod_cont != 0);
+
+  // live segments: head segment up to the tail segment
+  UnboundedSegment *seg =
+      atomic_load_explicit(&chan->head.segment, memory_order_acquire);
+  while (seg) {
+    UnboundedSegment *next =
+        atomic_load_explicit(&seg->next, memory_order_acquire);
+    free(seg);
+    seg = next;
+  }
+
+  // retired segments
+  size_t from = atomic_load_explicit(&chan->pool_tail.tail, memory_order_acquire);
+  size_t to = atomic_load_explicit(&chan->pool_head.head, memory_order_acquire);
+  for (size_t x = from; x < to; x++) {
+    free(chan->pool[x % UNBOUNDED_POOL_CAPACITY].segment);
+  }
+  free(chan);
+}
+
+SenderUnbounded *unbounded_get_sender(ChannelUnbounded *chan) {
+  if (!chan) {
+    return NULL;
+  }
+  SenderUnbounded *sender = malloc(sizeof(SenderUnbounded));
+  if (!sender) {
+    return NULL;
+  }
+  sender->chan = chan;
+  atomic_init(&sender->sender_state, OPEN);
+  atomic_fetch_add_explicit(&chan->prod_cont, 1, memory_order_release);
+  return sender;
+}
+
+ReceiverUnbounded *unbounded_get_receiver(ChannelUnbounded *chan) {
+  if (!chan) {
+    return NULL;
+  }
+  ReceiverUnbounded *receiver = malloc(sizeof(ReceiverUnbounded));
+  if (!receiver) {
+    return NULL;
+  }
+  receiver->chan = chan;
+  atomic_init(&receiver->receiver_state, OPEN);
+  atomic_fetch_add_explicit(&chan->cons_cont, 1, memory_order_release);
+  return receiver;
+}
+
+void unbounded_close_sender(SenderUnbounded *sender) {
+  atomic_fetch_sub_explicit(&sender->chan->prod_cont, 1, memory_order_release);
+  atomic_store_explicit(&sender->sender_state, CLOSED, memory_order_release);
+}
+
+void unbounded_close_receiver(ReceiverUnbounded *receiver) {
+  atomic_fetch_sub_explicit(&receiver->chan->cons_cont, 1,
+                            memory_order_release);
+  atomic_store_explicit(&receiver->receiver_state, CLOSED,
+                        memory_order_release);
+}
+
+int unbounded_send(SenderUnbounded *sender, const void *element) {
+  if (!sender) {
+    return CHANNEL_ERR_NULL;
+  }
+  ChannelUnbounded *chan = sender->chan;
+  if (atomic_load_explicit(&chan->state, memory_order_acquire) == CLOSED) {
+    return CHANNEL_ERR_CLOSED;
+  }
+
+  UnboundedSegment *next_seg = NULL;
+  size_t tail = atomic_load_explicit(&chan->tail.index, memory_order_acquire);
+  UnboundedSegment *seg =
+      atomic_load_explicit(&chan->tail.segment, memory_order_acquire);
+
+  for (;;) {
+    size_t offset = tail % UNBOUNDED_LAP;
+
+    // another producer is installing the next segment
+    if (offset == UNBOUNDED_SEGMENT_CAPACITY) {
+      cpu_relax();
+      tail = atomic_load_explicit(&chan->tail.index, memory_order_acquire);
+      seg = atomic_load_explicit(&chan->tail.segment, memory_order_acquire);
+      continue;
+    }
+
+    // about to take the last slot: have the next segment ready beforehand
+    // so the window where other producers wait stays short
+    if (offset + 1 == UNBOUNDED_SEGMENT_CAPACITY && !next_seg) {
+      next_seg = _unbounded_segment_get(chan);
+      if (!next_seg) {
+        return CHANNEL_ERR_FULL;
+      }
+    }
+
+    if (atomic_compare_exchange_weak_explicit(&chan->tail.index, &tail,
+                                              tail + 1, memory_order_seq_cst,
+                                              memory_order_acquire)) {
+      if (offset + 1 == UNBOUNDED_SEGMENT_CAPACITY) {
+        atomic_store_explicit(&chan->tail.segment, next_seg,
+                              memory_order_release);
+        atomic_fetch_add_explicit(&chan->tail.index, 1, memory_order_release);
+        atomic_store_explicit(&seg->next, next_seg, memory_order_release);
+        next_seg = NULL;
+      }
+
+      memcpy(seg->data + (offset * chan->elem_size), element, chan->elem_size);
+      atomic_fetch_or_explicit(&seg->state[offset], UNBOUNDED_SLOT_WRITE,
+                               memory_order_release);
+      break;
+    }
+
+    seg = atomic_load_explicit(&chan->tail.segment, memory_order_acquire);
+    cpu_relax();
+  }
+
+  _channel_signal_poke(&chan->signal);
+
+  if (next_seg) {
+    _unbounded_segment_put(chan, next_seg);
+  }
+  return CHANNEL_OK;
+}
+
+int unbounded_send_batch(SenderUnbounded *sender, const void *elements,
+                         size_t count, size_t *sent) {
+  if (sent) {
+    *sent = 0;
+  }
+  if (!sender || !elements) {
+    return CHANNEL_ERR_NULL;
+  }
+  ChannelUnbounded *chan = sender->chan;
+  if (atomic_load_explicit(&chan->state, memory_order_acquire) == CLOSED) {
+    return CHANNEL_ERR_CLOSED;
+  }
+
+  const uint8_t *src = elements;
+  size_t done = 0;
+  int res = CHANNEL_OK;
+  UnboundedSegment *next_seg = NULL;
+
+  while (done < count) {
+    size_t tail = atomic_load_explicit(&chan->tail.index, memory_order_acquire);
+    UnboundedSegment *seg =
+        atomic_load_explicit(&chan->tail.segment, memory_order_acquire);
+    size_t offset = tail % UNBOUNDED_LAP;
+
+    // another producer is installing the next segment
+    if (offset == UNBOUNDED_SEGMENT_CAPACITY) {
+      cpu_relax();
+      continue;
+    }
+
+    // the run ends at the segment boundary, taking its last slot means
+    // installing the next segment, like unbounded_send does
+    size_t run = UNBOUNDED_SEGMENT_CAPACITY - offset;
+    if (run > count - done) {
+      run = count - done;
+    }
+    int last = offset + run == UNBOUNDED_SEGMENT_CAPACITY;
+    if (last && !next_seg) {
+      next_seg = _unbounded_segment_get(chan);
+      if (!next_seg) {
+        res = CHANNEL_ERR_FULL;
+        break;
+      }
+    }
+
+    if (!atomic_compare_exchange_weak_explicit(&chan->tail.index, &tail,
+                                               tail + run, memory_order_seq_cst,
+                                               memory_order_acquire)) {
+      cpu_relax();
+      continue;
+    }
+    if (last) {
+      atomic_store_explicit(&chan->tail.segment, next_seg,
+                            memory_order_release);
+      atomic_fetch_add_explicit(&chan->tail.index, 1, memory_order_release);
+      atomic_store_explicit(&seg->next, next_seg, memory_order_release);
+      next_seg = NULL;
+    }
+
+    for (size_t x = 0; x < run; x++) {
+      memcpy(seg->data + ((offset + x) * chan->elem_size),
+             src + ((done + x) * chan->elem_size), chan->elem_size);
+      atomic_fetch_or_explicit(&seg->state[offset + x], UNBOUNDED_SLOT_WRITE,
+                               memory_order_release);
+    }
+    done += run;
+  }
+
+  if (done > 0) {
+    _channel_signal_poke(&chan->signal);
+  }
+  if (next_seg) {
+    _unbounded_segment_put(chan, next_seg);
+  }
+  if (sent) {
+    *sent = done;
+  }
+  return res;
+}
+
+int unbounded_try_recv(ReceiverUnbounded *receiver, void *out) {
+  if (!receiver) {
+    return CHANNEL_ERR_NULL;
+  }
+  if (atomic_load_explicit(&receiver->receiver_state, memory_order_acquire) ==
+      CLOSED) {
+    return CHANNEL_ERR_CLOSED;
+  }
+  ChannelUnbounded *chan = receiver->chan;
+
+  size_t head = atomic_load_explicit(&chan->head.index, memory_order_acquire);
+  UnboundedSegment *seg =
+      atomic_load_explicit(&chan->head.segment, memory_order_acquire);
+  size_t offset;
+
+  for (;;) {
+    offset = head % UNBOUNDED_LAP;
+
+    // another consumer is moving head to the next segment
+    if (offset == UNBOUNDED_SEGMENT_CAPACITY) {
+      cpu_relax();
+      head = atomic_load_explicit(&chan->head.index, memory_order_acquire);
+      seg = atomic_load_explicit(&chan->head.segment, memory_order_acquire);
+      continue;
+    }
+
+    size_t tail = atomic_load_explicit(&chan->tail.index, memory_order_seq_cst);
+    if (head == tail) {
+      if (atomic_load_explicit(&chan->state, memory_order_acquire) == CLOSED) {
+        // a send may have landed right before close
+        if (atomic_load_explicit(&chan->tail.index, memory_order_acquire) ==
+            head) {
+          return CHANNEL_ERR_CLOSED;
+        }
+        continue;
+      }
+      return CHANNEL_ERR_EMPTY;
+    }
+
+    if (atomic_compare_exchange_weak_explicit(&chan->head.index, &head,
+                                              head + 1, memory_order_seq_cst,
+                                              memory_order_acquire)) {
+      break;
+    }
+
+    seg = atomic_load_explicit(&chan->head.segment, memory_order_acquire);
+    cpu_relax();
+  }
+
+  // took the last slot: move head to the next segment (the producer of
+  // the last slot publishes it right after its own claim)
+  if (offset + 1 == UNBOUNDED_SEGMENT_CAPACITY) {
+    UnboundedSegment *next;
+    while (!(next = atomic_load_explicit(&seg->next, memory_order_acquire))) {
+      cpu_relax();
+    }
+    atomic_store_explicit(&chan->head.segment, next, memory_order_release);
+    atomic_fetch_add_explicit(&chan->head.index, 1, memory_order_release);
+  }
+
+  _Atomic size_t *state = &seg->state[offset];
+  while ((atomic_load_explicit(state, memory_order_acquire) &
+          UNBOUNDED_SLOT_WRITE) == 0) {
+    cpu_relax();
+  }
+  memcpy(out, seg->data + (offset * chan->elem_size), chan->elem_size);
+
+  if (offset + 1 == UNBOUNDED_SEGMENT_CAPACITY) {
+    _unbounded_segment_retire(chan, seg, 0);
+  } else if (atomic_fetch_or_explicit(state, UNBOUNDED_SLOT_READ,
+                                      memory_order_acq_rel) &
+             UNBOUNDED_SLOT_DESTROY) {
+    _unbounded_segment_retire(chan, seg, offset + 1);
+  }
+  return CHANNEL_OK;
+}
+
+int unbounded_recv(ReceiverUnbounded *receiver, void *out) {
+  int res;
+  while ((res = unbounded_try_recv(receiver, out)) == CHANNEL_ERR_EMPTY) {
+    cpu_relax();
+  }
+  return res;
+}
+#endif
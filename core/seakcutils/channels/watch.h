@@ -0,0 +1,291 @@
+// Copyright 2025 Seaker <seakerone@proton.me>
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/*
+------------------------------------------------------------------------------
+watch.h — Seqlock "latest value" channel (Single-Writer Multi-Reader)
+
+Much cross-thread state is overwrite-only: camera pose, latest gamepad
+axes, window size. Queueing every update makes readers drain stale values.
+A watch holds ONE value: the writer overwrites it without ever waiting,
+readers copy the latest consistent version.
+
+------------------------------------------------------------------------------
+PROTOCOL (seqlock)
+
+    writer: seq = odd  -> write value -> seq = even (release)
+    reader: s1 = seq (acquire), odd? retry
+            copy value
+            s2 = seq, s1 != s2? retry (the copy may be torn)
+
+The value is stored and copied in 8-byte words with relaxed atomics, so a
+torn read is detected instead of being undefined behaviour.
+
+version = seq / 2, it increases by one per publish. Readers keep the last
+version they saw and use watch_read_if_changed to skip work when nothing
+changed.
+
+------------------------------------------------------------------------------
+PROPERTIES
+
+- Writer is wait-free (two stores around the copy)
+- Readers are lock-free, they only retry while a publish overlaps them
+- Readers never write shared memory: any number of them, no contention
+- Exactly ONE writer thread at a time
+
+------------------------------------------------------------------------------
+*/
+#ifndef WATCH_CHANNEL_H
+#define WATCH_CHANNEL_H
+
+/*-------------------------------------------*/
+/*      Platform-dependent cpu_relax()       */
+/*-------------------------------------------*/
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+#define cpu_relax() _mm_pause()
+/*-------------------------------------------*/
+#elif defined(__aarch64__) || defined(__arm__)
+
+#define cpu_relax() __asm__ __volatile__("yield")
+/*-------------------------------------------*/
+#elif defined(__riscv)
+
+#define cpu_relax() __asm__ __volatile__("pause")
+/*-------------------------------------------*/
+#else
+#define cpu_relax() ((void)0)
+#endif
+/*-------------------------------------------*/
+
+#include <stddef.h>
+
+typedef struct ChannelWatch_t ChannelWatch;
+
+/*-----------------------------------------------------------------------------
+  channel_create_watch
+  Allocates a watch holding one value of elem_size bytes.
+
+  elem_size : size in bytes of the value
+  initial   : initial value (version 0), NULL for all zeroes
+
+  Returns a pointer to ChannelWatch on success, NULL on allocation failure.
+-----------------------------------------------------------------------------*/
+ChannelWatch *channel_create_watch(const size_t elem_size, const void *initial);
+
+/*-----------------------------------------------------------------------------
+  watch_destroy
+  Frees the watch. No reader or writer may use it afterwards.
+-----------------------------------------------------------------------------*/
+void watch_destroy(ChannelWatch *watch);
+
+/*-----------------------------------------------------------------------------
+  watch_publish
+  Replaces the value and bumps the version.
+
+  watch : pointer to the watch
+  value : pointer to elem_size bytes
+
+  Returns:
+    - CHANNEL_OK        on success
+    - CHANNEL_ERR_NULL  if an argument is NULL
+
+  Notes:
+    - Never waits. Must only be called from the single writer thread.
+-----------------------------------------------------------------------------*/
+int watch_publish(ChannelWatch *watch, const void *value);
+
+/*-----------------------------------------------------------------------------
+  watch_read
+  Copies the latest value.
+
+  watch   : pointer to the watch
+  out     : pointer to elem_size bytes
+  version : receives the version of the copied value (may be NULL)
+
+  Returns:
+    - CHANNEL_OK        on success
+    - CHANNEL_ERR_NULL  if watch or out is NULL
+
+  Notes:
+    - Retries (spinning) while a publish overlaps the copy.
+-----------------------------------------------------------------------------*/
+int watch_read(const ChannelWatch *watch, void *out, size_t *version);
+
+/*-----------------------------------------------------------------------------
+  watch_read_if_changed
+  Copies the latest value only if its version differs from *version.
+
+  version : in: last version seen by the caller, out: version copied
+
+  Returns:
+    - CHANNEL_OK        a newer value was copied
+    - CHANNEL_ERR_EMPTY nothing was published since *version (out untouched)
+    - CHANNEL_ERR_NULL  if an argument is NULL
+-----------------------------------------------------------------------------*/
+int watch_read_if_changed(const ChannelWatch *watch, void *out,
+                          size_t *version);
+
+/*-----------------------------------------------------------------------------
+  watch_version
+  Returns the version of the last completed publish (0 = initial value).
+-----------------------------------------------------------------------------*/
+size_t watch_version(const ChannelWatch *watch);
+
+#endif
+
+#if (defined(WATCH_IMPLEMENTATION))
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ChannelWatch_t {
+  alignas(CACHELINE_SIZE) _Atomic size_t seq; // odd while a publish runs
+  size_t elem_size;
+  size_t num_words;
+  _Atomic uint64_t *words; // value, rounded up to 8 bytes
+} ChannelWatch;
+
+ChannelWatch *channel_create_watch(const size_t elem_size, const void *initial) {
+  if (elem_size == 0) {
+    return NULL;
+  }
+  ChannelWatch *watch = aligned_alloc(CACHELINE_SIZE, sizeof(ChannelWatch));
+  if (!watch) {
+    return NULL;
+  }
+
+  watch->elem_size = elem_size;
+  watch->num_words = (elem_size + 7) / 8;
+  watch->words = calloc(watch->num_words, sizeof(uint64_t));
+  if (!watch->words) {
+    free(watch);
+    return NULL;
+  }
+  if (initial) {
+    memcpy((void *)watch->words, initial, elem_size);
+  }
+  atomic_init(&watch->seq, 0);
+  return watch;
+}
+
+void watch_destroy(ChannelWatch *watch) {
+  if (!watch) {
+    return;
+  }
+  free((void *)watch->words);
+  free(watch);
+}
+
+int watch_publish(ChannelWatch *watch, const void *value) {
+  if (!watch || !value) {
+    return CHANNEL_ERR_NULL;
+  }
+  const uint8_t *src = value;
+  size_t seq = atomic_load_explicit(&watch->seq, memory_order_relaxed);
+
+  atomic_store_explicit(&watch->seq, seq + 1, memory_order_relaxed);
+  // the odd sequence must be visible before any word of the new value
+  atomic_thread_fence(memory_order_release);
+
+  size_t full = watch->elem_size / 8;
+  for (size_t x = 0; x < full; x++) {
+    uint64_t word;
+    memcpy(&word, src + (x * 8), 8);
+    atomic_store_explicit(&watch->words[x], word, memory_order_relaxed);
+  }
+  if (full != watch->num_words) {
+    uint64_t word = 0;
+    memcpy(&word, src + (full * 8), watch->elem_size - (full * 8));
+    atomic_store_explicit(&watch->words[full], word, memory_order_relaxed);
+  }
+
+  atomic_store_explicit(&watch->seq, seq + 2, memory_order_release);
+  return CHANNEL_OK;
+}
+
+// One optimistic copy attempt. Returns the (even) sequence it copied, or
+// SIZE_MAX if a publish overlapped.
+static size_t _watch_try_copy(const ChannelWatch *watch, void *out,
+                              size_t s1) {
+  uint8_t *dst = out;
+  _Atomic uint64_t *words = watch->words;
+  size_t full = watch->elem_size / 8;
+
+  for (size_t x = 0; x < full; x++) {
+    uint64_t word = atomic_load_explicit(&words[x], memory_order_relaxed);
+    memcpy(dst + (x * 8), &word, 8);
+  }
+  if (full != watch->num_words) {
+    uint64_t word = atomic_load_explicit(&words[full], memory_order_relaxed);
+    memcpy(dst + (full * 8), &word, watch->elem_size - (full * 8));
+  }
+
+  // the copy must complete before the sequence is checked again
+  atomic_thread_fence(memory_order_acquire);
+  size_t s2 = atomic_load_explicit(&watch->seq, memory_order_relaxed);
+  return s1 == s2 ? s1 : SIZE_MAX;
+}
+
+int watch_read(const ChannelWatch *watch, void *out, size_t *version) {
+  if (!watch || !out) {
+    return CHANNEL_ERR_NULL;
+  }
+  for (;;) {
+    size_t s1 = atomic_load_explicit(&watch->seq, memory_order_acquire);
+    if ((s1 & 1) == 0 && _watch_try_copy(watch, out, s1) == s1) {
+      if (version) {
+        *version = s1 / 2;
+      }
+      return CHANNEL_OK;
+    }
+    cpu_relax();
+  }
+}
+
+int watch_read_if_changed(const ChannelWatch *watch, void *out,
+                          size_t *version) {
+  if (!watch || !out || !version) {
+    return CHANNEL_ERR_NULL;
+  }
+  for (;;) {
+    size_t s1 = atomic_load_explicit(&watch->seq, memory_order_acquire);
+    if ((s1 & 1) == 0) {
+      if (s1 / 2 == *version) {
+        return CHANNEL_ERR_EMPTY; // nothing new, skip the copy
+      }
+      if (_watch_try_copy(watch, out, s1) == s1) {
+        *version = s1 / 2;
+        return CHANNEL_OK;
+      }
+    }
+    cpu_relax();
+  }
+}
+
+size_t watch_version(const ChannelWatch *watch) {
+  size_t seq = atomic_load_explicit(&watch->seq, memory_order_acquire);
+  return seq / 2; // a publish in progress still reports the previous one
+}
+#endif
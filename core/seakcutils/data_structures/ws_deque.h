@@ -0,0 +1,227 @@
+// Copyright 2025 Seaker <seakerone@proton.me>
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#ifndef WS_DEQUE_H
+#define WS_DEQUE_H
+
+// Chase-Lev work-stealing deque (fixed capacity, pointer elements).
+//
+// One owner thread pushes and pops at the bottom (LIFO), any number of
+// thieves steal from the top (FIFO). The owner only touches `top` when the
+// deque is down to its last element, so the common path is uncontended.
+//
+// C11 memory orderings follow Le, Pop, Cohen, Zappa Nardelli,
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP '13).
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef CACHELINE_SIZE
+#define CACHELINE_SIZE 64
+#endif
+
+#define WS_DEQUE_OK 0
+#define WS_DEQUE_ERR_NULL -1
+#define WS_DEQUE_ERR_EMPTY -2
+#define WS_DEQUE_ERR_ABORT -3
+#define WS_DEQUE_ERR_FULL -4
+
+typedef struct WsDeque_T {
+  alignas(CACHELINE_SIZE) _Atomic int64_t top;    // thieves
+  alignas(CACHELINE_SIZE) _Atomic int64_t bottom; // owner
+  alignas(CACHELINE_SIZE) _Atomic(void *) *items;
+  size_t mask;
+} WsDeque;
+
+/*-----------------------------------------------------------------------------
+  ws_deque_init
+  Allocates the buffer of a work-stealing deque.
+
+  q   : deque to initialise
+  cap : maximum number of elements, rounded up to a power of two
+
+  Returns:
+    - 0  on success
+    - -1 if q is NULL or the allocation failed
+
+  Notes:
+    - The deque never grows, a full push fails instead (see ws_deque_push).
+-----------------------------------------------------------------------------*/
+int ws_deque_init(WsDeque *q, size_t cap);
+
+/*-----------------------------------------------------------------------------
+  ws_deque_push
+  Pushes an item at the bottom. Owner thread only.
+
+  Returns:
+    - 0  on success
+    - -1 if q is NULL
+    - -4 if the deque is full
+-----------------------------------------------------------------------------*/
+int ws_deque_push(WsDeque *q, void *item);
+
+/*-----------------------------------------------------------------------------
+  ws_deque_pop
+  Pops the most recently pushed item (LIFO). Owner thread only.
+
+  Returns:
+    - 0  on success, item written to out
+    - -1 if q is NULL
+    - -2 if the deque is empty (or a thief took the last item)
+-----------------------------------------------------------------------------*/
+int ws_deque_pop(WsDeque *q, void **out);
+
+/*-----------------------------------------------------------------------------
+  ws_deque_steal
+  Takes the oldest item (FIFO). Any thread.
+
+  Returns:
+    - 0  on success, item written to out
+    - -1 if q is NULL
+    - -2 if the deque is empty
+    - -3 if another thread won the race, the deque may still hold items
+
+  Notes:
+    - Callers typically move on to the next victim on -3 instead of
+      retrying the same deque.
+-----------------------------------------------------------------------------*/
+int ws_deque_steal(WsDeque *q, void **out);
+
+/*-----------------------------------------------------------------------------
+  ws_deque_size
+  Approximate number of items, exact only when called by the owner with no
+  concurrent thieves.
+-----------------------------------------------------------------------------*/
+size_t ws_deque_size(WsDeque *q);
+
+/*-----------------------------------------------------------------------------
+  ws_deque_free
+  Frees the buffer. No thread may use the deque afterwards.
+-----------------------------------------------------------------------------*/
+void ws_deque_free(WsDeque *q);
+
+#endif // !WS_DEQUE_H
+
+#if (defined(WS_DEQUE_IMPLEMENTATION))
+#include <stdlib.h>
+
+int ws_deque_init(WsDeque *q, size_t cap) {
+  if (!q)
+    return WS_DEQUE_ERR_NULL;
+
+  size_t c = 1;
+  while (c < cap)
+    c <<= 1;
+
+  q->items = malloc(c * sizeof(*q->items));
+  if (!q->items)
+    return WS_DEQUE_ERR_NULL;
+
+  for (size_t i = 0; i < c; i++)
+    atomic_init(&q->items[i], NULL);
+
+  q->mask = c - 1;
+  atomic_init(&q->top, 0);
+  atomic_init(&q->bottom, 0);
+  return WS_DEQUE_OK;
+}
+
+int ws_deque_push(WsDeque *q, void *item) {
+  if (!q || !q->items)
+    return WS_DEQUE_ERR_NULL;
+
+  int64_t b = atomic_load_explicit(&q->bottom, memory_order_relaxed);
+  int64_t t = atomic_load_explicit(&q->top, memory_order_acquire);
+  if (b - t > (int64_t)q->mask)
+    return WS_DEQUE_ERR_FULL;
+
+  atomic_store_explicit(&q->items[b & (int64_t)q->mask], item,
+                        memory_order_relaxed);
+  // publishes the item (and whatever it points to) to thieves
+  atomic_store_explicit(&q->bottom, b + 1, memory_order_release);
+  return WS_DEQUE_OK;
+}
+
+int ws_deque_pop(WsDeque *q, void **out) {
+  if (!q || !q->items)
+    return WS_DEQUE_ERR_NULL;
+
+  int64_t b = atomic_load_explicit(&q->bottom, memory_order_relaxed) - 1;
+  atomic_store_explicit(&q->bottom, b, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  int64_t t = atomic_load_explicit(&q->top, memory_order_relaxed);
+
+  if (t > b) {
+    // already empty
+    atomic_store_explicit(&q->bottom, b + 1, memory_order_relaxed);
+    return WS_DEQUE_ERR_EMPTY;
+  }
+
+  void *item = atomic_load_explicit(&q->items[b & (int64_t)q->mask],
+                                    memory_order_relaxed);
+  if (t == b) {
+    // last item, race the thieves for it
+    int won = atomic_compare_exchange_strong_explicit(
+        &q->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&q->bottom, b + 1, memory_order_relaxed);
+    if (!won)
+      return WS_DEQUE_ERR_EMPTY;
+  }
+
+  *out = item;
+  return WS_DEQUE_OK;
+}
+
+int ws_deque_steal(WsDeque *q, void **out) {
+  if (!q || !q->items)
+    return WS_DEQUE_ERR_NULL;
+
+  int64_t t = atomic_load_explicit(&q->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  int64_t b = atomic_load_explicit(&q->bottom, memory_order_acquire);
+  if (t >= b)
+    return WS_DEQUE_ERR_EMPTY;
+
+  void *item = atomic_load_explicit(&q->items[t & (int64_t)q->mask],
+                                    memory_order_relaxed);
+  if (!atomic_compare_exchange_strong_explicit(
+          &q->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+    return WS_DEQUE_ERR_ABORT;
+
+  *out = item;
+  return WS_DEQUE_OK;
+}
+
+size_t ws_deque_size(WsDeque *q) {
+  int64_t b = atomic_load_explicit(&q->bottom, memory_order_relaxed);
+  int64_t t = atomic_load_explicit(&q->top, memory_order_relaxed);
+  return (b > t) ? (size_t)(b - t) : 0;
+}
+
+void ws_deque_free(WsDeque *q) {
+  if (!q->items)
+    return;
+
+  free(q->items);
+  q->items = NULL;
+}
+#endif
@@ -23,14 +23,27 @@
 ===========================================================================
  JOB SYSTEM
 ===========================================================================
-Job System: Lock-free job scheduler built on top of a ThreadPool, MPMC
-channels, and JobHandles.
+Job System: Lock-free job scheduler built on top of a ThreadPool, an
+unbounded channel, and JobHandles.
 
 Features:
   - Spawn independent jobs
+  - Work stealing: jobs scheduled from a worker go to its own deque
   - Support for dependent jobs (job_then, job_chain, job_chain_arr)
+  - Job DAGs: fan-in / fan-out dependencies with job_depends_on
+  - Data-parallel loops with job_parallel_for (the caller helps)
+  - job_join: wait for a job while running other pending jobs
+  - Priority classes (critical / normal / background), strict selection,
+    optional workers that never run background jobs
+  - Fiber mode (JOBSYSTEM_FIBERS): jobs run on pooled fibers and
+    job_await suspends them instead of blocking the worker
+  - Recorded job graphs: build a frame's graph once, launch it every
+    frame without spawning
+  - Profiler (JOBSYSTEM_PROFILE): per-thread event rings exported as a
+    Chrome trace / Perfetto JSON file
   - Compatible with WaitGroups
-  - Automatic arena reset when job count nears max capacity
+  - Continuous JobHandle recycling (per-thread caches + a shared free
+    list), the scheduler never pauses to reclaim memory
   - Lock-free scheduling with atomic counters
 
 Typical usage:
@@ -40,7 +53,12 @@ Typical usage:
 
   2. Spawn independent jobs:
         JobHandle *job = job_spawn(func, ctx);
+        // or copy a small context into the handle (no malloc / free):
+        //   JobHandle *job = job_spawn_with(func, &args, sizeof(args));
+        job_retain(job);  // only needed to touch it after scheduling
         job_wait(job);
+        job_join(job);    // returns once it has run
+        job_release(job);
 
   3. Spawn dependent jobs:
         JobHandle *A = job_spawn(funcA, ctxA);
@@ -51,7 +69,44 @@ Typical usage:
         JobHandle *jobs[3] = {job1, job2, job3};
         job_chain_arr(3, jobs); // executes sequentially
 
-  5. Shutdown:
+  5. Fan-in (C runs after both A and B):
+        JobHandle *parents[2] = {A, B};
+        job_depends_on(C, parents, 2);
+        job_wait(A);
+        job_wait(B);
+
+  6. Data-parallel loop over [0, count), chunks of at least 256 items:
+        void update(size_t begin, size_t end, void *ctx) { ... }
+        job_parallel_for(0, count, 256, update, entities);
+
+  7. Priorities:
+        job_set_priority(stream_job, JOB_PRIORITY_BACKGROUND);
+        job_set_priority(skinning_job, JOB_PRIORITY_CRITICAL);
+        job_scheduler_reserve_foreground(2); // workers 0-1 skip background
+
+  8. Fibers (x86-64, define JOBSYSTEM_FIBERS and include yield.h first):
+        JobHandle *child = job_spawn(func, ctx);
+        job_retain(child);
+        job_wait(child);
+        job_await(child);   // this job is suspended, the worker moves on
+        job_release(child);
+
+  9. Profiling (define JOBSYSTEM_PROFILE):
+        job_set_label(job, "skinning");
+        ...
+        job_profile_export_chrome("frame.json"); // open in ui.perfetto.dev
+
+  10. Recorded graph, built once, launched every frame:
+        JobGraph *frame = job_graph_create();
+        size_t anim = job_graph_add(frame, animate, scene);
+        size_t skin = job_graph_add(frame, skin_meshes, scene);
+        job_graph_depends_on(frame, skin, anim);
+        job_graph_seal(frame);
+        ...
+        job_graph_launch(frame);
+        job_graph_wait(frame);
+
+  11. Shutdown:
         job_scheduler_shutdown();
 
 ===========================================================================
@@ -60,6 +115,18 @@ CONSTANTS
 JOB_SCHEDULER_REGION_CAPACITY : Arena region size (4096)
 JOB_SCHEDULER_MAX_REGIONS     : Maximum regions (1024)
 JOB_SCHEDULER_MAX_JOBS        : Maximum jobs = CAPACITY * MAX_REGIONS
+JOB_SCHEDULER_LOCAL_CAPACITY  : Per-worker deque size (4096), overridable
+JOB_MAX_SUCCESSORS            : Successors stored inline per job (4),
+                                more go on a heap list, overridable
+JOB_HANDLE_CACHE_SIZE         : Free handles kept per thread before they
+                                go to the shared free list (256), overridable
+JOB_INLINE_CTX_SIZE           : Context bytes stored in the handle by
+                                job_spawn_with (48), overridable
+JOB_FIBER_POOL_SIZE           : Fibers created at most (128), overridable
+JOB_FIBER_STACK_SIZE          : Stack of each fiber (64 KiB, plus a guard
+                                page), overridable
+JOB_PROFILE_RING_SIZE         : Profiler events kept per thread (8192),
+                                overridable
 
 ===========================================================================
 MAIN TYPES
@@ -67,21 +134,49 @@ MAIN TYPES
 
 Scheduler:
   - ThreadPool *threadpool          : pointer to internal thread pool
-  - _Atomic uint8_t accepting_jobs  : 0 = not accepting, 1 = accepting
-  - _Atomic size_t active_jobs      : number of active jobs
-  - _Atomic size_t jobs_completed_epoch : jobs executed since last reset
+  - _Atomic size_t active_jobs      : jobs spawned and not yet run
   - RegionArena job_arena           : arena storing JobHandles
+  - JobHandle *free_handles         : shared free list (Treiber stack)
 
 JobHandle:
   - __job_handle Job               : function to execute
   - void *ctx                      : user-provided context pointer
-  - _Atomic size_t unfinished      : counter for dependencies
-  - JobHandle *continuation        : pointer to dependent job
+  - uint8_t owns_ctx                : ctx is a heap copy made by
+                                      job_spawn_with, freed with the handle
+  - unsigned char payload[]        : inline context (JOB_INLINE_CTX_SIZE)
+  - _Atomic size_t unfinished      : 1 + number of unfinished parents
+  - _Atomic size_t refs             : pending run + queue entries + retains
+  - uint8_t priority                : JobPriority, picks the lane it is
+                                      queued on
+  - _Atomic uint32_t num_successors : successor count, sealed when done
+  - JobHandle *successors[]        : jobs released when this one finishes
+  - JobSuccessorNode *overflow      : successors past JOB_MAX_SUCCESSORS
+  - JobFiber *fiber                 : (fibers) the fiber of a suspended job
+  - const char *label, spawn_ns     : (profiler) trace name, spawn time
+
+JobPriority:
+  - JOB_PRIORITY_CRITICAL   : frame critical path, always taken first
+  - JOB_PRIORITY_NORMAL     : default
+  - JOB_PRIORITY_BACKGROUND : streaming / loading, only when nothing else
+                              is queued, never on reserved workers
+
+JobGraph:
+  - Nodes (function, context, embedded JobHandle) in one array
+  - Successors of every node in one array, grouped by node
+  - Root handles, submitted together on launch
+  - _Atomic size_t remaining        : nodes of the current launch not run
 
 ThreadPool:
   - Array of worker threads
-  - Each worker consumes jobs from an MPMC channel
-  - Runs jobs and schedules dependent continuations
+  - Each worker owns one Chase-Lev deque per priority
+    (see data_structures/ws_deque.h)
+  - For each priority, highest first, a worker takes jobs from: its own
+    deque (LIFO), then the shared queue of that priority (external
+    submissions, an unbounded channel that grows in segments with the
+    number of queued jobs), then steals from the other deques (FIFO)
+  - Runs jobs and schedules the successors they release on its own deque,
+    so a continuation usually runs next on the same, cache-warm, worker
+  - Idle workers park on the pool signal, every scheduled job wakes one
 
 ===========================================================================
 MAIN FUNCTIONS
@@ -89,11 +184,18 @@ MAIN FUNCTIONS
 
 ThreadPool *threadpool_init_for_scheduler(size_t num_threads)
   - Creates a thread pool for the scheduler
-  - Initializes lock-free MPMC channels for job dispatch
+  - Creates the shared job queue (unbounded channel, one segment at
+    start-up) and one deque per worker slot
+
+ThreadPool *threadpool_init_for_scheduler_ex(size_t num_threads,
+                                             const ThreadPoolOptions *opts)
+  - Same, with CPU pinning / NUMA / naming and elastic sizing options
+    (see threadpool.h, threadpool_resize works on scheduler pools too)
 
 void job_scheduler_spawn(ThreadPool *threadpool)
   - Initializes the global scheduler (g_scheduler)
-  - Allocates internal arena for JobHandles
+  - Allocates internal arena for JobHandles (filled lazily, handles are
+    recycled, so it only bounds the number of live jobs)
 
 void job_scheduler_shutdown(void)
   - Shuts down the scheduler and thread pool
@@ -105,29 +207,181 @@ JobHandle *job_spawn(__job_handle fn, void *ctx)
       - job_then
       - job_chain / job_chain_arr
       - job_wait
-
-void job_then(JobHandle *first, JobHandle *then)
+  - The handle is recycled as soon as the job has run: keep it with
+    job_retain to use it after scheduling (job_join, job_depends_on)
+  - Returns NULL if JOB_SCHEDULER_MAX_JOBS jobs are alive
+
+JobHandle *job_spawn_with(__job_handle fn, const void *ctx, size_t size)
+  - job_spawn with a copy of `size` bytes at `ctx`, the job receives a
+    pointer to the copy (aligned like malloc)
+  - Up to JOB_INLINE_CTX_SIZE bytes the copy lives in the handle, no
+    allocation; larger contexts get one heap copy
+  - The copy is released with the handle, once the job has run and every
+    retain is released: the caller's args can be a local variable
+  - Returns NULL like job_spawn (or if the heap copy fails)
+
+void job_set_priority(JobHandle *job, JobPriority priority)
+  - Sets the lane the job is queued on, call it before scheduling
+  - job_spawn inherits the priority of the job running on the calling
+    thread (NORMAL outside jobs), so work spawned by a background job
+    stays background
+
+void job_scheduler_reserve_foreground(size_t num_workers)
+  - Workers in slots [0, num_workers) never run background jobs, so
+    critical / normal work always finds a worker that isn't stuck in a
+    long streaming job. Threads helping in job_join / job_parallel_for
+    never run background jobs either.
+  - Clamped to min_threads - 1, so at least one live worker is left for
+    background jobs even when an elastic pool has shrunk, applies to the
+    jobs workers pick after the call
+
+void job_retain(JobHandle *job) / void job_release(JobHandle *job)
+  - Keeps the handle valid after it has run, every retain needs a release
+
+int job_then(JobHandle *first, JobHandle *then)
   - Schedules `then` to execute **after** `first` finishes
-
-void job_chain(size_t num_jobs, ...)
+  - `first` is scheduled immediately
+  - Returns 0, or -1 if out of memory (nothing is scheduled)
+
+int job_depends_on(JobHandle *job, JobHandle **parents, size_t num_parents)
+  - `job` runs once every parent has finished, it is scheduled by the
+    last parent to finish (or right away if all parents are done)
+  - Parents are not scheduled, submit them with job_wait / job_submit_n
+  - A parent already scheduled must be retained, its handle could
+    otherwise be recycled under the call
+  - Returns 0, or -1 if out of memory: `job` is then never scheduled
+
+int job_chain(size_t num_jobs, ...)
   - Creates a sequential chain of jobs using variadic arguments
+  - Returns 0, or -1 if out of memory (nothing is scheduled)
 
-void job_chain_arr(size_t num_jobs, JobHandle **job_list)
+int job_chain_arr(size_t num_jobs, JobHandle **job_list)
   - Creates a sequential chain of jobs using an array
+  - Returns 0, or -1 if out of memory (nothing is scheduled)
 
 void job_wait(JobHandle *job)
   - Schedules the job for execution immediately
   - Can be used for independent jobs or as the root of a chain
 
+void job_submit_n(size_t num_jobs, JobHandle **job_list)
+  - Schedules every job of the array, like job_wait in a loop
+  - From a worker: pushed on its deque, overflow goes to the shared queue
+  - Otherwise: appended to the shared queue, one batch per priority (one
+    tail CAS per segment instead of one per job)
+  - Wakes up to num_jobs parked workers with a single futex call
+
+void job_join(JobHandle *job)
+  - Blocks until `job` has run, executing other pending jobs on the
+    calling thread meanwhile (own deque, channel, then stealing)
+  - Safe to call from inside a job: a worker joining never idles, so
+    nested joins can't starve the pool
+  - `job` must have been scheduled (job_wait, job_then, job_depends_on...)
+    and retained (job_retain) before it was scheduled
+
+void job_parallel_for(size_t begin, size_t end, size_t grain,
+                      __job_range_handle fn, void *ctx)
+  - Calls fn(chunk_begin, chunk_end, ctx) over disjoint chunks covering
+    [begin, end), returns once every chunk has run
+  - Ranges are halved recursively down to `grain` items; each split hands
+    the upper half to the pool (thieves take the largest halves first)
+    and keeps the lower half
+  - grain == 0 picks one from the pool size (about 8 chunks per worker)
+  - The caller runs chunks, and any other pending job, while it waits;
+    it is safe to call from inside a job
+
+void job_await(JobHandle *job)
+  - Returns once `job` has run, same requirements as job_join
+  - With JOBSYSTEM_FIBERS, from a job running on a fiber: the fiber is
+    suspended and parked on `job` (as a successor), the worker picks
+    other work, the last step of `job` queues the fiber again and any
+    worker resumes it
+  - Otherwise (fibers off, outside a job, pool exhausted) it is job_join
+
+void job_await_counter(_Atomic size_t *counter)
+  - Returns once *counter is 0 (job_parallel_for style counters, WaitGroup
+    counts, ...)
+  - On a fiber: suspends and goes to the back of the shared queue until
+    the counter drops, otherwise helps like job_join
+
+void job_set_label(JobHandle *job, const char *label)
+  - Name of the job in profiles, `label` must outlive the export (string
+    literals). No-op without JOBSYSTEM_PROFILE.
+
+int job_profile_export_chrome(const char *path)
+  - Writes the recorded events to `path` in the Chrome trace event format
+    (chrome://tracing, ui.perfetto.dev): one track per thread, one slice
+    per job run with its worker and spawn -> start delay (queue_us)
+  - Can be called while jobs run, events being overwritten are skipped
+  - Returns 0, or -1 if the file can't be written or JOBSYSTEM_PROFILE
+    is off
+
+void job_profile_clear(void)
+  - Drops the events recorded so far (e.g. at the start of each frame)
+
+JobGraph *job_graph_create(void)
+size_t job_graph_add(JobGraph *graph, __job_handle fn, void *ctx)
+int job_graph_depends_on(JobGraph *graph, size_t node, size_t parent)
+  - Records nodes (index returned by job_graph_add, (size_t)-1 on error)
+    and edges (0, or -1 on error), nothing runs yet
+  - Any number of parents and successors per node, no JOB_MAX_SUCCESSORS
+  - A node inherits the priority of the calling job, like job_spawn
+
+int job_graph_seal(JobGraph *graph)
+  - Ends the recording, lays out the successors and finds the roots
+  - Returns 0, or -1 if the graph has a cycle (it stays open)
+
+void job_graph_set_ctx(JobGraph *graph, size_t node, void *ctx)
+  - Context of the node from the next launch on, the per-frame data
+
+JobHandle *job_graph_node(JobGraph *graph, size_t node)
+  - Handle of a sealed node, for job_set_priority / job_set_label only
+
+int job_graph_launch(JobGraph *graph)
+  - Resets one counter per node and submits the roots: no job_spawn, no
+    allocation. Returns -1 if the graph isn't sealed.
+  - Relaunching first waits (helping) for the previous launch
+
+void job_graph_wait(JobGraph *graph)
+  - Returns once every node of the launch has run, helps like job_join
+    (suspends on a fiber, see job_await_counter)
+
+void job_graph_destroy(JobGraph *graph)
+  - Waits for a running launch, then frees the graph
+
 ===========================================================================
 IMPORTANT NOTES
 ===========================================================================
 - All internal counters are atomic for lock-free thread safety.
-- Scheduler performs automatic health checks to reset the arena
-  when the job count approaches JOB_SCHEDULER_MAX_JOBS.
-- JobHandle::unfinished ensures proper synchronization of dependent jobs.
-- job_then / job_chain increment and decrement unfinished correctly.
+- A handle holds one reference until it has run plus one per queue entry,
+  so a job dropped from the queue (parents pending) never points to a
+  recycled handle. Freed handles go to the thread's cache, then to the
+  shared free list, job_spawn takes from both before touching the arena.
+- JobHandle::unfinished ensures proper synchronization of dependent jobs:
+  a job is released exactly once, by the parent that brings it to 1.
+- A job's successor list is sealed when it finishes, an edge added after
+  that is already satisfied. Successors past JOB_MAX_SUCCESSORS take one
+  small allocation each, freed when the parent finishes.
+- Do not job_wait a job that has parents, the last parent schedules it.
 - Uses RegionArena to reduce malloc/free overhead.
+- Jobs scheduled outside the pool, or while the caller's deque is full,
+  go through the shared queue. It never fills up and its memory follows
+  the number of queued jobs, not JOB_SCHEDULER_MAX_JOBS.
+- Graph nodes own their JobHandles (outside the arena, never recycled),
+  the graph keeps a reference on each, so a launch touches only the
+  graph's own memory.
+- Profiler: each thread records into its own ring (last
+  JOB_PROFILE_RING_SIZE runs), created on its first job and freed by
+  job_scheduler_shutdown, so export before shutting down. A worker that
+  retires leaves its ring to the next worker of its slot, an elastic pool
+  keeps one ring per slot. Recording is two
+  clock reads and one release store per run, no locks or shared writes.
+- Fibers: a job may finish on another thread than the one it started on.
+  Don't keep thread-local state (errno, pointers to _Thread_local data,
+  TLS addresses cached by -fPIC code) across job_await. Fibers are
+  created on demand up to JOB_FIBER_POOL_SIZE, a job started while all
+  of them are busy or suspended runs on the worker's stack and its
+  job_await falls back to job_join. An awaited job takes the waiter as a
+  successor.
 
 ===========================================================================
 USAGE EXAMPLE
@@ -135,10 +389,16 @@ USAGE EXAMPLE
 
 #define REGION_ARENA_IMPLEMENTATION
 #include "./arenas/r_arena.h"
+#define WS_DEQUE_IMPLEMENTATION
+#include "data_structures/ws_deque.h"
 #define CHANNEL_BASICS_IMPLEMENTATION
 #include "channels/channels.h"
 #define MPMC_IMPLEMENTATION
 #include "channels/mpmc.h"
+#define UNBOUNDED_IMPLEMENTATION
+#include "channels/unbounded.h"
+#define TOPOLOGY_IMPLEMENTATION
+#include "threadpool/topology.h"
 #define THREADPOOL_IMPLEMENTATION
 #include "threadpool/threadpool.h"
 #define JOBSYSTEM_IMPLEMENTATION
@@ -162,7 +422,6 @@ typedef struct {
   int id;
   int parent_id;
   WaitGroup *wg_root_ref;
-  RootCtx *r_ctx;
 } InnerJobCtx;
 
 void phase2_task_inner_job(void *ctx) {
@@ -180,13 +439,10 @@ void phase2_job(void *ctx) {
   wg_add(r_ctx->wg_ref, num_inner_task_jobs);
 
   // Each phase2 job will run 2 jobs in sequence
+  // contexts are copied into the handles, nothing to free
   for (int x = 0; x < num_inner_task_jobs; x++) {
-    InnerJobCtx *ctx = malloc(sizeof(InnerJobCtx));
-    ctx->id = x;
-    ctx->parent_id = r_ctx->id;
-    ctx->wg_root_ref = r_ctx->wg_ref;
-    ctx->r_ctx = r_ctx;
-    jobs[x] = job_spawn(phase2_task_inner_job, ctx);
+    InnerJobCtx ctx = {x, r_ctx->id, r_ctx->wg_ref};
+    jobs[x] = job_spawn_with(phase2_task_inner_job, &ctx, sizeof(ctx));
   }
 
   job_chain_arr(num_inner_task_jobs, jobs);
@@ -199,10 +455,8 @@ void phase2_root(void *ctx) {
   printf("Phase 2 root \n");
 
   for (size_t i = 0; i < root_wg->count; ++i) {
-    RootCtx *ctx = malloc(sizeof(RootCtx));
-    ctx->id = (int)i;
-    ctx->wg_ref = root_wg;
-    JobHandle *t = job_spawn(phase2_job, ctx);
+    RootCtx ctx = {(int)i, root_wg};
+    JobHandle *t = job_spawn_with(phase2_job, &ctx, sizeof(ctx));
     job_wait(t);
   }
 }
@@ -241,6 +495,7 @@ job_scheduler_shutdown();
 #define JOB_SYSTEM_H
 
 typedef struct ThreadPool_t ThreadPool;
+typedef struct ThreadPoolOptions_t ThreadPoolOptions;
 
 #include <stddef.h>
 
@@ -249,7 +504,37 @@ typedef struct ThreadPool_t ThreadPool;
 #define JOB_SCHEDULER_MAX_JOBS                                                 \
   (JOB_SCHEDULER_REGION_CAPACITY * JOB_SCHEDULER_MAX_REGIONS)
 
+#ifndef JOB_SCHEDULER_LOCAL_CAPACITY
+#define JOB_SCHEDULER_LOCAL_CAPACITY 4096
+#endif
+
+#ifndef JOB_MAX_SUCCESSORS
+#define JOB_MAX_SUCCESSORS 4
+#endif
+
+#ifndef JOB_HANDLE_CACHE_SIZE
+#define JOB_HANDLE_CACHE_SIZE 256
+#endif
+
+#ifndef JOB_INLINE_CTX_SIZE
+#define JOB_INLINE_CTX_SIZE 48
+#endif
+
+#ifndef JOB_FIBER_POOL_SIZE
+#define JOB_FIBER_POOL_SIZE 128
+#endif
+
+#ifndef JOB_FIBER_STACK_SIZE
+#define JOB_FIBER_STACK_SIZE (64 * 1024)
+#endif
+
+#ifndef JOB_PROFILE_RING_SIZE
+#define JOB_PROFILE_RING_SIZE 8192
+#endif
+
 ThreadPool *threadpool_init_for_scheduler(size_t num_threads);
+ThreadPool *threadpool_init_for_scheduler_ex(size_t num_threads,
+                                             const ThreadPoolOptions *opts);
 
 typedef struct JobHandle_t JobHandle;
 
@@ -257,42 +542,222 @@ typedef struct Scheduler_t Scheduler;
 extern Scheduler *g_scheduler;
 
 typedef void (*__job_handle)(void *);
+typedef void (*__job_range_handle)(size_t begin, size_t end, void *ctx);
+
+typedef enum JobPriority_t {
+  JOB_PRIORITY_CRITICAL = 0,
+  JOB_PRIORITY_NORMAL = 1,
+  JOB_PRIORITY_BACKGROUND = 2,
+  JOB_PRIORITY_COUNT
+} JobPriority;
 
 void job_scheduler_spawn(ThreadPool *threadpool);
 void job_scheduler_shutdown(void);
+void job_scheduler_reserve_foreground(size_t num_workers);
 
 JobHandle *job_spawn(__job_handle fn, void *ctx);
-void job_chain(size_t num_jobs, ...);
-void job_chain_arr(size_t num_jobs, JobHandle **job_list);
-void job_then(JobHandle *first, JobHandle *then);
+JobHandle *job_spawn_with(__job_handle fn, const void *ctx, size_t size);
+void job_set_priority(JobHandle *job, JobPriority priority);
+void job_retain(JobHandle *job);
+void job_release(JobHandle *job);
+int job_chain(size_t num_jobs, ...);
+int job_chain_arr(size_t num_jobs, JobHandle **job_list);
+int job_then(JobHandle *first, JobHandle *then);
+int job_depends_on(JobHandle *job, JobHandle **parents, size_t num_parents);
 void job_wait(JobHandle *job);
+void job_submit_n(size_t num_jobs, JobHandle **job_list);
+void job_join(JobHandle *job);
+void job_parallel_for(size_t begin, size_t end, size_t grain,
+                      __job_range_handle fn, void *ctx);
+void job_await(JobHandle *job);
+void job_await_counter(_Atomic size_t *counter);
+
+void job_set_label(JobHandle *job, const char *label);
+int job_profile_export_chrome(const char *path);
+void job_profile_clear(void);
+
+typedef struct JobGraph_t JobGraph;
+
+JobGraph *job_graph_create(void);
+size_t job_graph_add(JobGraph *graph, __job_handle fn, void *ctx);
+int job_graph_depends_on(JobGraph *graph, size_t node, size_t parent);
+int job_graph_seal(JobGraph *graph);
+void job_graph_set_ctx(JobGraph *graph, size_t node, void *ctx);
+JobHandle *job_graph_node(JobGraph *graph, size_t node);
+int job_graph_launch(JobGraph *graph);
+void job_graph_wait(JobGraph *graph);
+void job_graph_destroy(JobGraph *graph);
 
 #endif
 
 #if (defined(JOBSYSTEM_IMPLEMENTATION))
 #include <assert.h>
+#include <stdalign.h>
 #include <stdarg.h>
 #include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#if defined(JOBSYSTEM_FIBERS)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 typedef struct RegionArena_t RegionArena;
-typedef struct SenderMpmc_t SenderMpmc;
+typedef struct ChannelUnbounded_t ChannelUnbounded;
+typedef struct SenderUnbounded_t SenderUnbounded;
+typedef struct ReceiverUnbounded_t ReceiverUnbounded;
 
 Scheduler *g_scheduler = NULL;
 
+// one deque per priority per scheduler worker, owned by the scheduler's
+// thread pool: worker `w` lane `p` is g_job_deques[w * JOB_PRIORITY_COUNT + p]
+static WsDeque *g_job_deques = NULL;
+static size_t g_job_num_deques = 0; // number of workers
+// shared queues for jobs scheduled outside the pool (or on a full deque),
+// one per priority, one sender / receiver used by every thread
+static ChannelUnbounded *g_job_queue[JOB_PRIORITY_COUNT];
+static SenderUnbounded *g_job_submitter[JOB_PRIORITY_COUNT];
+static ReceiverUnbounded *g_job_receiver[JOB_PRIORITY_COUNT];
+// workers in slots below this never run background jobs
+static _Atomic size_t g_job_reserved = 0;
+// index of the calling thread's deques, -1 outside the pool
+static _Thread_local int64_t g_job_worker_id = -1;
+// priority of the job running on this thread, inherited by job_spawn
+static _Thread_local uint8_t g_job_current_priority = JOB_PRIORITY_NORMAL;
+
+#define _job_deque(worker, lane)                                               \
+  (&g_job_deques[(size_t)(worker) * JOB_PRIORITY_COUNT + (lane)])
+
+// free handles owned by this thread, only valid for the scheduler instance
+// `generation` was filled from
+typedef struct {
+  JobHandle *head;
+  JobHandle *tail;
+  size_t count;
+  size_t generation;
+} JobHandleCache;
+static _Thread_local JobHandleCache g_job_cache = {NULL, NULL, 0, 0};
+static size_t g_job_generation = 0;
+
+#if defined(JOBSYSTEM_FIBERS)
+typedef enum {
+  JOB_FIBER_RUNNING,
+  JOB_FIBER_DONE,
+  JOB_FIBER_AWAIT, // suspended until `await` has run
+  JOB_FIBER_YIELD, // suspended, queued again right away
+} JobFiberState;
+
+// A pooled stack running one job at a time. `rsp` is the fiber's saved
+// context, `caller_rsp` the one of the thread that resumed it last.
+typedef struct JobFiber_t {
+  void *rsp;
+  void *caller_rsp;
+  void *stack;
+  size_t stack_size;
+  struct JobHandle_t *job;
+  struct JobHandle_t *await;
+  JobFiberState state;
+} JobFiber;
+
+// idle fibers, `g_job_fibers_created` of JOB_FIBER_POOL_SIZE exist
+static ChannelMpmc *g_job_fiber_pool = NULL;
+static SenderMpmc *g_job_fiber_free = NULL;
+static ReceiverMpmc *g_job_fiber_take = NULL;
+static _Atomic size_t g_job_fibers_created = 0;
+static JobFiber *g_job_fibers[JOB_FIBER_POOL_SIZE];
+// fiber running on this thread, NULL on a thread's own stack
+static _Thread_local JobFiber *g_job_current_fiber = NULL;
+
+static void _job_fiber_pool_init(void);
+static void _job_fiber_pool_free(void);
+static JobFiber *_job_fiber_acquire(void);
+static void _job_fiber_resume(struct JobHandle_t *job, JobFiber *fiber);
+static void _job_fiber_main(void *arg);
+static void _job_requeue(struct JobHandle_t *job);
+static JobFiber *_job_fiber_self(void);
+static void _job_fiber_suspend(JobFiber *self, JobFiberState state,
+                               struct JobHandle_t *await);
+#endif
+
+#if defined(JOBSYSTEM_PROFILE)
+// One run of a job on a worker (a fiber job records one per resume).
+typedef struct {
+  const char *label;
+  __job_handle fn;
+  uint64_t spawn_ns; // 0 for the later slices of a suspended job
+  uint64_t start_ns;
+  uint64_t end_ns;
+  int32_t worker;
+  uint8_t priority;
+} JobProfileEvent;
+
+// Events of one thread, written by that thread only. `head` counts every
+// event recorded, the ring keeps the last JOB_PROFILE_RING_SIZE.
+typedef struct JobProfileRing_t {
+  _Atomic uint64_t head;
+  _Atomic uint64_t cleared; // events below this index are not exported
+  uint32_t id;
+  int32_t worker; // worker slot of the owning thread, -1 outside the pool
+  _Atomic uint8_t owned; // 0 once its worker exited, the slot's next takes it
+  struct JobProfileRing_t *next;
+  JobProfileEvent events[JOB_PROFILE_RING_SIZE];
+} JobProfileRing;
+
+// every ring ever created, freed at shutdown: one per worker slot plus one
+// per thread outside the pool that ran a job
+static JobProfileRing *_Atomic g_job_profile_rings = NULL;
+static _Atomic uint32_t g_job_profile_next_id = 0;
+static _Thread_local JobProfileRing *g_job_profile_ring = NULL;
+static _Thread_local size_t g_job_profile_generation = 0;
+
+static uint64_t _job_profile_now(void);
+static void _job_profile_record(struct JobHandle_t *job, uint64_t start_ns,
+                                uint64_t end_ns);
+static void _job_profile_free(void);
+static void _job_profile_release(void);
+#endif
+
 static void *__set_worker_scheduler(void *arg);
-static void _job_scheduler_healthcheck(void);
-static void threadpool_schedule(SenderMpmc *sender, JobHandle *scheduled_job);
+static int _job_worker_poll(Worker *worker, void *out);
+static size_t _job_backlog(ThreadPool *tp);
+static int _job_poll(int64_t self, JobHandle **out);
+static size_t _job_reserved(void);
+static void _job_notify(ThreadPool *tp, uint8_t lane, size_t n);
+static int _job_poll_lane(int64_t self, int lane, JobHandle **out);
+static void _job_execute(JobHandle *job);
+static void _job_finish(JobHandle *job);
+static int _job_help_one(void);
+static void _job_help_while(_Atomic size_t *counter);
+static JobHandle *_job_alloc(void);
+static void _job_unref(JobHandle *job, size_t n);
+static void _job_cache_flush(void);
+static void _job_range_split(void *ctx);
+static void threadpool_schedule(JobHandle *scheduled_job);
+static int _job_add_successor(JobHandle *parent, JobHandle *job);
+static int _job_add_overflow(JobHandle *parent, JobHandle *job);
+static size_t _job_release_successors(JobHandle *job);
+
+// set in num_successors once the job has finished
+#define JOB_SUCCESSORS_SEALED 0x80000000u
+
+// successor past the inline ones, pushed on the parent's overflow list
+typedef struct JobSuccessorNode_t {
+  struct JobHandle_t *job;
+  struct JobSuccessorNode_t *next;
+} JobSuccessorNode;
+
+// head of the overflow list once the job has finished
+static JobSuccessorNode g_job_overflow_sealed;
+#define JOB_OVERFLOW_SEALED (&g_job_overflow_sealed)
 
 typedef struct Scheduler_t {
   ThreadPool *threadpool;
-  _Atomic uint8_t accepting_jobs; // 0 -> accepting or 1 -> not accepting
   _Atomic size_t active_jobs;
-  _Atomic size_t jobs_completed_epoch;
   RegionArena job_arena;
+  struct JobHandle_t *_Atomic free_handles;
 } Scheduler;
 
 typedef struct JobHandle_t {
@@ -300,7 +765,22 @@ typedef struct JobHandle_t {
   void *ctx;
 
   _Atomic size_t unfinished;
-  struct JobHandle_t *continuation;
+  _Atomic size_t refs;
+  struct JobHandle_t *next_free;
+  uint8_t priority;
+  uint8_t owns_ctx; // ctx is a heap copy, freed with the handle
+  _Atomic uint32_t num_successors;
+  struct JobHandle_t *_Atomic successors[JOB_MAX_SUCCESSORS];
+  JobSuccessorNode *_Atomic overflow; // successors past the inline ones
+#if defined(JOBSYSTEM_FIBERS)
+  JobFiber *fiber; // set while the job is suspended
+#endif
+#if defined(JOBSYSTEM_PROFILE)
+  const char *label;
+  uint64_t spawn_ns; // 0 once the first run slice is recorded
+#endif
+  // job_spawn_with copies small contexts here
+  alignas(max_align_t) unsigned char payload[JOB_INLINE_CTX_SIZE];
 } JobHandle;
 
 void job_scheduler_spawn(ThreadPool *threadpool) {
@@ -309,50 +789,173 @@ void job_scheduler_spawn(ThreadPool *threadpool) {
       r_arena_create(sizeof(JobHandle), JOB_SCHEDULER_REGION_CAPACITY,
                      JOB_SCHEDULER_MAX_REGIONS);
   sche->threadpool = threadpool;
-  atomic_init(&sche->accepting_jobs, 1);
   atomic_init(&sche->active_jobs, 0);
-  atomic_init(&sche->jobs_completed_epoch, 0);
+  atomic_init(&sche->free_handles, NULL);
+  // thread caches filled by a previous scheduler point into a freed arena
+  g_job_generation++;
+#if defined(JOBSYSTEM_FIBERS)
+  _job_fiber_pool_init();
+#endif
   g_scheduler = sche;
 };
 
 void job_scheduler_shutdown(void) {
+  // workers exit once the queues are closed and drained
+  for (int p = 0; p < JOB_PRIORITY_COUNT; p++) {
+    unbounded_close(g_job_queue[p]);
+  }
   threadpool_shutdown(g_scheduler->threadpool);
+  for (int p = 0; p < JOB_PRIORITY_COUNT; p++) {
+    unbounded_close_sender(g_job_submitter[p]);
+    unbounded_close_receiver(g_job_receiver[p]);
+    free(g_job_submitter[p]);
+    free(g_job_receiver[p]);
+    unbounded_destroy(g_job_queue[p]);
+    g_job_submitter[p] = NULL;
+    g_job_receiver[p] = NULL;
+    g_job_queue[p] = NULL;
+  }
+  for (size_t i = 0; i < g_job_num_deques * JOB_PRIORITY_COUNT; i++) {
+    ws_deque_free(&g_job_deques[i]);
+  }
+  free(g_job_deques);
+  g_job_deques = NULL;
+  g_job_num_deques = 0;
+#if defined(JOBSYSTEM_FIBERS)
+  _job_fiber_pool_free();
+#endif
+#if defined(JOBSYSTEM_PROFILE)
+  _job_profile_free();
+#endif
   r_arena_free(&g_scheduler->job_arena);
   free(g_scheduler);
 };
 
 JobHandle *job_spawn(__job_handle fn, void *ctx) {
-  // small contention, rare to be needed as scheduler temporarily doesnt accept
-  // jobs only when it needs to reset the inner arena
-  while (atomic_load_explicit(&g_scheduler->accepting_jobs,
-                              memory_order_acquire) != 1) {
-    cpu_relax();
-  }
-  atomic_fetch_add_explicit(&g_scheduler->active_jobs, 1, memory_order_acq_rel);
-
-  JobHandle *job = (JobHandle *)r_arena_alloc(&g_scheduler->job_arena);
+  JobHandle *job = _job_alloc();
   if (!job) {
-    atomic_fetch_sub_explicit(&g_scheduler->active_jobs, 1,
-                              memory_order_acq_rel);
     return NULL;
   }
+  atomic_fetch_add_explicit(&g_scheduler->active_jobs, 1, memory_order_acq_rel);
+
   job->Job = fn;
   job->ctx = ctx;
   atomic_init(&job->unfinished, 1);
-  job->continuation = NULL;
+  // released once the job has run
+  atomic_init(&job->refs, 1);
+  job->next_free = NULL;
+  job->priority = g_job_current_priority;
+  job->owns_ctx = 0;
+  atomic_init(&job->num_successors, 0);
+  for (size_t i = 0; i < JOB_MAX_SUCCESSORS; i++) {
+    atomic_init(&job->successors[i], NULL);
+  }
+  atomic_init(&job->overflow, NULL);
+#if defined(JOBSYSTEM_FIBERS)
+  job->fiber = NULL;
+#endif
+#if defined(JOBSYSTEM_PROFILE)
+  job->label = NULL;
+  job->spawn_ns = _job_profile_now();
+#endif
   return job;
 };
 
+void job_set_priority(JobHandle *job, JobPriority priority) {
+  assert(priority < JOB_PRIORITY_COUNT);
+  job->priority = (uint8_t)priority;
+}
+
+JobHandle *job_spawn_with(__job_handle fn, const void *ctx, size_t size) {
+  // too big for the handle: one heap copy, freed when the handle is recycled
+  void *heap = NULL;
+  if (size > JOB_INLINE_CTX_SIZE) {
+    heap = malloc(size);
+    if (!heap) {
+      return NULL;
+    }
+    memcpy(heap, ctx, size);
+  }
+  JobHandle *job = job_spawn(fn, heap);
+  if (!job) {
+    free(heap);
+    return NULL;
+  }
+  if (heap) {
+    job->owns_ctx = 1;
+  } else {
+    if (size > 0) {
+      memcpy(job->payload, ctx, size);
+    }
+    job->ctx = job->payload;
+  }
+  return job;
+}
+
+void job_set_label(JobHandle *job, const char *label) {
+#if defined(JOBSYSTEM_PROFILE)
+  job->label = label;
+#else
+  (void)job;
+  (void)label;
+#endif
+}
+
+void job_scheduler_reserve_foreground(size_t num_workers) {
+  // clamped when polling, the pool's minimum may change later
+  atomic_store_explicit(&g_job_reserved, num_workers, memory_order_relaxed);
+}
+
+void job_retain(JobHandle *job) {
+  atomic_fetch_add_explicit(&job->refs, 1, memory_order_relaxed);
+}
+
+void job_release(JobHandle *job) { _job_unref(job, 1); }
+
 /* this will schedule `first` and `then` when `first` finishes */
-void job_then(JobHandle *first, JobHandle *then) {
-  first->continuation = then;
-  atomic_fetch_add_explicit(&then->unfinished, 1, memory_order_release);
-  threadpool_schedule(g_scheduler->threadpool->dispatcher, first);
+int job_then(JobHandle *first, JobHandle *then) {
+  if (job_depends_on(then, &first, 1) != 0) {
+    return -1;
+  }
+  threadpool_schedule(first);
+  return 0;
 };
 
-void job_chain(size_t num_jobs, ...) {
+int job_depends_on(JobHandle *job, JobHandle **parents, size_t num_parents) {
+  int res = 0;
+  // hold the job while wiring so a parent finishing meanwhile can't release
+  // it before the remaining edges are in place
+  atomic_fetch_add_explicit(&job->unfinished, 1, memory_order_acq_rel);
+
+  for (size_t i = 0; i < num_parents; i++) {
+    atomic_fetch_add_explicit(&job->unfinished, 1, memory_order_acq_rel);
+    int linked = _job_add_successor(parents[i], job);
+    if (linked != 0) {
+      // parent already finished (1) or out of memory (-1): no edge to wait on
+      atomic_fetch_sub_explicit(&job->unfinished, 1, memory_order_acq_rel);
+      if (linked < 0) {
+        res = -1;
+        break;
+      }
+    }
+  }
+
+  if (res != 0) {
+    // a parent is missing, keep the guard so the job never runs early
+    return res;
+  }
+  if (atomic_fetch_sub_explicit(&job->unfinished, 1, memory_order_acq_rel) ==
+      2) {
+    // every parent is done already
+    threadpool_schedule(job);
+  }
+  return res;
+}
+
+int job_chain(size_t num_jobs, ...) {
   va_list args;
   JobHandle *job_to_schedule;
+  int res = 0;
 
   uint8_t first = 1;
   JobHandle *prev_job;
@@ -364,18 +967,28 @@ void job_chain(size_t num_jobs, ...) {
       prev_job = job;
       first = 0;
     } else {
-      prev_job->continuation = job;
+      // links are made before the chain is scheduled, they only fail when
+      // out of memory: then nothing is scheduled
       atomic_fetch_add_explicit(&job->unfinished, 1, memory_order_release);
+      if (_job_add_successor(prev_job, job) != 0) {
+        atomic_fetch_sub_explicit(&job->unfinished, 1, memory_order_release);
+        res = -1;
+        break;
+      }
       prev_job = job;
     }
   }
   va_end(args);
 
-  threadpool_schedule(g_scheduler->threadpool->dispatcher, job_to_schedule);
+  if (res == 0) {
+    threadpool_schedule(job_to_schedule);
+  }
+  return res;
 }
 
-void job_chain_arr(size_t num_jobs, JobHandle **job_list) {
+int job_chain_arr(size_t num_jobs, JobHandle **job_list) {
   JobHandle *job_to_schedule;
+  int res = 0;
 
   uint8_t first = 1;
   JobHandle *prev_job;
@@ -386,109 +999,1244 @@ void job_chain_arr(size_t num_jobs, JobHandle **job_list) {
       prev_job = job;
       first = 0;
     } else {
-      prev_job->continuation = job;
+      // links are made before the chain is scheduled, they only fail when
+      // out of memory: then nothing is scheduled
       atomic_fetch_add_explicit(&job->unfinished, 1, memory_order_release);
+      if (_job_add_successor(prev_job, job) != 0) {
+        atomic_fetch_sub_explicit(&job->unfinished, 1, memory_order_release);
+        res = -1;
+        break;
+      }
       prev_job = job;
     }
   }
 
-  threadpool_schedule(g_scheduler->threadpool->dispatcher, job_to_schedule);
+  if (res == 0) {
+    threadpool_schedule(job_to_schedule);
+  }
+  return res;
 }
 
 void job_wait(JobHandle *job) {
-  threadpool_schedule(g_scheduler->threadpool->dispatcher, job);
+  threadpool_schedule(job);
 };
 
-ThreadPool *threadpool_init_for_scheduler(size_t num_threads) {
-  ThreadPool *tp = malloc(sizeof(ThreadPool));
+// Handles job_submit_n gathers per lane before one shared queue batch.
+#define JOB_SUBMIT_CHUNK 64
+
+// Queues `count` handles on the shared queue of `lane` in one batch, the
+// ones that couldn't be queued drop their queue reference. Returns the
+// number queued.
+static size_t _job_queue_batch(int lane, JobHandle **jobs, size_t count) {
+  size_t sent = 0;
+  unbounded_send_batch(g_job_submitter[lane], jobs, count, &sent);
+  for (size_t x = sent; x < count; x++) {
+    _job_unref(jobs[x], 1);
+  }
+  return sent;
+}
+
+void job_submit_n(size_t num_jobs, JobHandle **job_list) {
+  ThreadPool *tp = g_scheduler->threadpool;
+  size_t queued = 0;
+  uint8_t background = 0;
+  // bound for the shared queue, sent one batch per lane
+  JobHandle *pending[JOB_PRIORITY_COUNT][JOB_SUBMIT_CHUNK];
+  size_t num_pending[JOB_PRIORITY_COUNT] = {0};
+
+  for (size_t x = 0; x < num_jobs; x++) {
+    JobHandle *job = job_list[x];
+    if (atomic_load_explicit(&job->unfinished, memory_order_acquire) == 0) {
+      continue;
+    }
+    // the queue entry holds a reference
+    job_retain(job);
+    background |= job->priority == JOB_PRIORITY_BACKGROUND;
+    // from inside a job: keep it on this worker's deque while it fits,
+    // otherwise the shared queue
+    if (g_job_worker_id >= 0 &&
+        ws_deque_push(_job_deque(g_job_worker_id, job->priority), job) ==
+            WS_DEQUE_OK) {
+      queued++;
+      continue;
+    }
+    uint8_t lane = job->priority;
+    pending[lane][num_pending[lane]++] = job;
+    if (num_pending[lane] == JOB_SUBMIT_CHUNK) {
+      queued += _job_queue_batch(lane, pending[lane], JOB_SUBMIT_CHUNK);
+      num_pending[lane] = 0;
+    }
+  }
+  for (int lane = 0; lane < JOB_PRIORITY_COUNT; lane++) {
+    if (num_pending[lane] > 0) {
+      queued += _job_queue_batch(lane, pending[lane], num_pending[lane]);
+    }
+  }
+
+  if (queued > 0) {
+    _job_notify(tp, background ? JOB_PRIORITY_BACKGROUND : JOB_PRIORITY_NORMAL,
+                queued);
+    _threadpool_maybe_grow(tp, _job_backlog(tp));
+  }
+}
+
+typedef struct {
+  __job_range_handle fn;
+  void *ctx;
+  size_t grain;
+  _Atomic size_t remaining; // items not run yet, 0 -> loop done
+  _Atomic size_t next_split;
+  size_t max_splits;
+  struct JobRangeSplit_t *splits;
+} JobParallelFor;
+
+typedef struct JobRangeSplit_t {
+  JobParallelFor *pf;
+  size_t begin;
+  size_t end;
+} JobRangeSplit;
+
+// Hands the upper half to the pool until the range fits in a grain, then
+// runs what is left.
+static void _job_range_run(JobParallelFor *pf, size_t begin, size_t end) {
+  while (end - begin > pf->grain) {
+    size_t slot =
+        atomic_fetch_add_explicit(&pf->next_split, 1, memory_order_relaxed);
+    if (slot >= pf->max_splits) {
+      break;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    JobRangeSplit *split = &pf->splits[slot];
+    split->pf = pf;
+    split->begin = mid;
+    split->end = end;
+    JobHandle *job = job_spawn(_job_range_split, split);
+    if (!job) {
+      break;
+    }
+    threadpool_schedule(job);
+    end = mid;
+  }
+
+  pf->fn(begin, end, pf->ctx);
+  // last access to pf, the caller may return as soon as this hits 0
+  atomic_fetch_sub_explicit(&pf->remaining, end - begin, memory_order_acq_rel);
+}
+
+static void _job_range_split(void *ctx) {
+  JobRangeSplit *split = ctx;
+  _job_range_run(split->pf, split->begin, split->end);
+}
+
+void job_parallel_for(size_t begin, size_t end, size_t grain,
+                      __job_range_handle fn, void *ctx) {
+  if (end <= begin) {
+    return;
+  }
+  size_t count = end - begin;
+  if (grain == 0) {
+    grain = count / (g_scheduler->threadpool->num_workers * 8);
+  }
+  if (grain == 0) {
+    grain = 1;
+  }
+
+  JobParallelFor pf;
+  pf.fn = fn;
+  pf.ctx = ctx;
+  pf.grain = grain;
+  atomic_init(&pf.remaining, count);
+  atomic_init(&pf.next_split, 0);
+  // halving stops below 2 * grain, so leaves hold more than grain / 2 items
+  pf.max_splits = 2 * (count / grain) + 1;
+  pf.splits = malloc(pf.max_splits * sizeof(JobRangeSplit));
+  if (!pf.splits) {
+    pf.max_splits = 0;
+  }
+
+  _job_range_run(&pf, begin, end);
+
+  _job_help_while(&pf.remaining);
+  free(pf.splits);
+}
+
+void job_join(JobHandle *job) {
+  _job_help_while(&job->unfinished);
+}
+
+void job_await(JobHandle *job) {
+#if defined(JOBSYSTEM_FIBERS)
+  JobFiber *self = _job_fiber_self();
+  if (self) {
+    // the worker parks the fiber on `job` once it has switched out of it
+    while (atomic_load_explicit(&job->unfinished, memory_order_acquire) != 0) {
+      _job_fiber_suspend(self, JOB_FIBER_AWAIT, job);
+    }
+    return;
+  }
+#endif
+  job_join(job);
+}
+
+void job_await_counter(_Atomic size_t *counter) {
+#if defined(JOBSYSTEM_FIBERS)
+  JobFiber *self = _job_fiber_self();
+  if (self) {
+    // nothing to be woken by: go to the back of the queue until it is 0
+    while (atomic_load_explicit(counter, memory_order_acquire) != 0) {
+      _job_fiber_suspend(self, JOB_FIBER_YIELD, NULL);
+    }
+    return;
+  }
+#endif
+  _job_help_while(counter);
+}
+
+// A recorded node: its JobHandle lives here for the graph's whole life, the
+// graph holds a reference so it never goes back to the free lists.
+typedef struct JobGraphNode_t {
+  JobHandle handle;
+  struct JobGraph_t *graph;
+  __job_handle fn;
+  void *ctx;
+  uint32_t num_parents;
+  uint32_t first_successor; // range of JobGraph::successors
+  uint32_t num_successors;
+} JobGraphNode;
+
+typedef struct JobGraph_t {
+  JobGraphNode *nodes;
+  size_t num_nodes;
+  size_t cap_nodes;
+  // recording: (parent, node) pairs, replaced by `successors` when sealed
+  uint32_t *edges;
+  size_t num_edges;
+  size_t cap_edges;
+  // sealed: successor indices grouped by parent, handles of the roots
+  uint32_t *successors;
+  JobHandle **roots;
+  size_t num_roots;
+  uint8_t sealed;
+  _Atomic size_t remaining; // nodes of the current launch not run yet
+} JobGraph;
+
+static void _job_graph_run(void *ctx);
+static void _job_graph_quiesce(JobGraph *graph);
+
+JobGraph *job_graph_create(void) {
+  JobGraph *graph = calloc(1, sizeof(JobGraph));
+  if (!graph) {
+    return NULL;
+  }
+  atomic_init(&graph->remaining, 0);
+  return graph;
+}
+
+// Records a node, returns its index or (size_t)-1 (sealed graph, out of
+// memory). The node inherits the priority of the calling job, like job_spawn.
+size_t job_graph_add(JobGraph *graph, __job_handle fn, void *ctx) {
+  if (graph->sealed || graph->num_nodes >= UINT32_MAX) {
+    return (size_t)-1;
+  }
+  if (graph->num_nodes == graph->cap_nodes) {
+    size_t cap = graph->cap_nodes ? graph->cap_nodes * 2 : 16;
+    void *nodes = realloc(graph->nodes, cap * sizeof(JobGraphNode));
+    if (!nodes) {
+      return (size_t)-1;
+    }
+    graph->nodes = nodes;
+    graph->cap_nodes = cap;
+  }
+  JobGraphNode *node = &graph->nodes[graph->num_nodes];
+  memset(node, 0, sizeof(JobGraphNode));
+  node->fn = fn;
+  node->ctx = ctx;
+  node->handle.priority = g_job_current_priority;
+  return graph->num_nodes++;
+}
+
+// `node` runs after `parent` on every launch. Returns 0, or -1 (sealed
+// graph, bad index, out of memory).
+int job_graph_depends_on(JobGraph *graph, size_t node, size_t parent) {
+  if (graph->sealed || node >= graph->num_nodes ||
+      parent >= graph->num_nodes) {
+    return -1;
+  }
+  if (graph->num_edges == graph->cap_edges) {
+    size_t cap = graph->cap_edges ? graph->cap_edges * 2 : 32;
+    void *edges = realloc(graph->edges, cap * 2 * sizeof(uint32_t));
+    if (!edges) {
+      return -1;
+    }
+    graph->edges = edges;
+    graph->cap_edges = cap;
+  }
+  graph->edges[2 * graph->num_edges] = (uint32_t)parent;
+  graph->edges[2 * graph->num_edges + 1] = (uint32_t)node;
+  graph->num_edges++;
+  return 0;
+}
+
+// Ends the recording: groups successors per node in one array, finds the
+// roots and sets up the handles. Returns 0, or -1 if the graph has a cycle
+// (or on allocation failure), it then stays open.
+int job_graph_seal(JobGraph *graph) {
+  if (graph->sealed) {
+    return 0;
+  }
+  size_t n = graph->num_nodes;
+  uint32_t *successors = malloc((graph->num_edges + 1) * sizeof(uint32_t));
+  uint32_t *pending = malloc((n + 1) * sizeof(uint32_t));
+  JobHandle **roots = malloc((n + 1) * sizeof(JobHandle *));
+  if (!successors || !pending || !roots) {
+    free(successors);
+    free(pending);
+    free(roots);
+    return -1;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    graph->nodes[i].num_parents = 0;
+    graph->nodes[i].num_successors = 0;
+  }
+  for (size_t e = 0; e < graph->num_edges; e++) {
+    graph->nodes[graph->edges[2 * e]].num_successors++;
+    graph->nodes[graph->edges[2 * e + 1]].num_parents++;
+  }
+  uint32_t offset = 0;
+  for (size_t i = 0; i < n; i++) {
+    graph->nodes[i].first_successor = offset;
+    offset += graph->nodes[i].num_successors;
+    graph->nodes[i].num_successors = 0;
+  }
+  for (size_t e = 0; e < graph->num_edges; e++) {
+    JobGraphNode *parent = &graph->nodes[graph->edges[2 * e]];
+    successors[parent->first_successor + parent->num_successors++] =
+        graph->edges[2 * e + 1];
+  }
+
+  // Kahn's walk: every node must be reachable from a root
+  size_t num_roots = 0, visited = 0;
+  for (size_t i = 0; i < n; i++) {
+    pending[i] = graph->nodes[i].num_parents;
+    if (pending[i] == 0) {
+      roots[num_roots++] = &graph->nodes[i].handle;
+    }
+  }
+  uint32_t *order = malloc((n + 1) * sizeof(uint32_t));
+  if (!order) {
+    free(successors);
+    free(pending);
+    free(roots);
+    return -1;
+  }
+  for (size_t i = 0; i < num_roots; i++) {
+    order[i] = (uint32_t)((JobGraphNode *)roots[i] - graph->nodes);
+  }
+  size_t tail = num_roots;
+  while (visited < tail) {
+    JobGraphNode *node = &graph->nodes[order[visited++]];
+    for (uint32_t s = 0; s < node->num_successors; s++) {
+      uint32_t next = successors[node->first_successor + s];
+      if (--pending[next] == 0) {
+        order[tail++] = next;
+      }
+    }
+  }
+  free(order);
+  free(pending);
+  if (visited != n) {
+    free(successors);
+    free(roots);
+    return -1;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    JobGraphNode *node = &graph->nodes[i];
+    JobHandle *job = &node->handle;
+    uint8_t priority = job->priority;
+    memset(job, 0, sizeof(JobHandle));
+    node->graph = graph;
+    job->Job = _job_graph_run;
+    job->ctx = node;
+    job->priority = priority;
+    atomic_init(&job->unfinished, 0);
+    // the graph's own reference, never dropped
+    atomic_init(&job->refs, 1);
+    atomic_init(&job->num_successors, 0);
+    for (size_t x = 0; x < JOB_MAX_SUCCESSORS; x++) {
+      atomic_init(&job->successors[x], NULL);
+    }
+    atomic_init(&job->overflow, NULL);
+  }
+
+  free(graph->edges);
+  graph->edges = NULL;
+  graph->successors = successors;
+  graph->roots = roots;
+  graph->num_roots = num_roots;
+  graph->sealed = 1;
+  return 0;
+}
+
+// Context passed to the node's function from the next launch on.
+void job_graph_set_ctx(JobGraph *graph, size_t node, void *ctx) {
+  assert(node < graph->num_nodes);
+  graph->nodes[node].ctx = ctx;
+}
+
+JobHandle *job_graph_node(JobGraph *graph, size_t node) {
+  assert(graph->sealed && node < graph->num_nodes);
+  return &graph->nodes[node].handle;
+}
+
+int job_graph_launch(JobGraph *graph) {
+  if (!graph->sealed) {
+    return -1;
+  }
+  // a node of the previous launch may still be between its function and
+  // its last reference drop
+  _job_graph_quiesce(graph);
+  if (graph->num_nodes == 0) {
+    return 0;
+  }
+
+  atomic_store_explicit(&graph->remaining, graph->num_nodes,
+                        memory_order_relaxed);
+  atomic_fetch_add_explicit(&g_scheduler->active_jobs, graph->num_nodes,
+                            memory_order_acq_rel);
+  for (size_t i = 0; i < graph->num_nodes; i++) {
+    JobGraphNode *node = &graph->nodes[i];
+    JobHandle *job = &node->handle;
+    atomic_store_explicit(&job->unfinished, 1 + (size_t)node->num_parents,
+                          memory_order_relaxed);
+    atomic_store_explicit(&job->num_successors, 0, memory_order_relaxed);
+    // a release spins on empty slots, don't leave last launch's edges there
+    for (size_t x = 0; x < JOB_MAX_SUCCESSORS; x++) {
+      atomic_store_explicit(&job->successors[x], NULL, memory_order_relaxed);
+    }
+    atomic_store_explicit(&job->overflow, NULL, memory_order_relaxed);
+    // the pending run
+    atomic_fetch_add_explicit(&job->refs, 1, memory_order_relaxed);
+#if defined(JOBSYSTEM_PROFILE)
+    job->spawn_ns = _job_profile_now();
+#endif
+  }
+  // the queue push publishes the resets above
+  job_submit_n(graph->num_roots, graph->roots);
+  return 0;
+}
+
+void job_graph_wait(JobGraph *graph) {
+  job_await_counter(&graph->remaining);
+}
+
+void job_graph_destroy(JobGraph *graph) {
+  if (!graph) {
+    return;
+  }
+  if (graph->sealed) {
+    _job_graph_quiesce(graph);
+  }
+  free(graph->nodes);
+  free(graph->edges);
+  free(graph->successors);
+  free(graph->roots);
+  free(graph);
+}
 
-  tp->workers = malloc(num_threads * sizeof(pthread_t));
-  tp->num_workers = num_threads;
+// Function of every node's handle: runs the recorded function, then
+// releases the successors whose last parent this was.
+static void _job_graph_run(void *ctx) {
+  JobGraphNode *node = ctx;
+  JobGraph *graph = node->graph;
+  node->fn(node->ctx);
+
+  uint32_t *next = &graph->successors[node->first_successor];
+  for (uint32_t i = 0; i < node->num_successors; i++) {
+    JobHandle *job = &graph->nodes[next[i]].handle;
+    if (atomic_fetch_sub_explicit(&job->unfinished, 1, memory_order_acq_rel) ==
+        2) {
+      threadpool_schedule(job);
+    }
+  }
+  atomic_fetch_sub_explicit(&graph->remaining, 1, memory_order_acq_rel);
+}
 
-  tp->channel =
-      channel_create_mpmc(JOB_SCHEDULER_MAX_JOBS, sizeof(JobHandle *));
-  tp->dispatcher = mpmc_get_sender(tp->channel);
+// Runs pending jobs until every node is back to the graph's reference only.
+static void _job_graph_quiesce(JobGraph *graph) {
+  for (size_t i = 0; i < graph->num_nodes; i++) {
+    JobHandle *job = &graph->nodes[i].handle;
+    while (atomic_load_explicit(&job->refs, memory_order_acquire) != 1) {
+      if (!_job_help_one()) {
+        cpu_relax();
+      }
+    }
+  }
+}
 
-  for (size_t i = 0; i < num_threads; i++) {
-    Worker *worker = malloc(sizeof(Worker));
-    worker->receiver = mpmc_get_receiver(tp->channel);
-    worker->sender = mpmc_get_sender(tp->channel);
-    worker->chan_ref = tp->channel;
+ThreadPool *threadpool_init_for_scheduler(size_t num_threads) {
+  return threadpool_init_for_scheduler_ex(num_threads, NULL);
+}
 
-    pthread_create(&tp->workers[i], NULL, __set_worker_scheduler, worker);
+ThreadPool *threadpool_init_for_scheduler_ex(size_t num_threads,
+                                             const ThreadPoolOptions *opts) {
+  ThreadPool *tp = _threadpool_alloc(num_threads, opts, __set_worker_scheduler);
+
+  // the pool's own MPMC channel stays NULL, workers poll the shared queue:
+  // it starts with one segment and grows with the jobs actually queued
+  tp->backlog = _job_backlog;
+  for (int p = 0; p < JOB_PRIORITY_COUNT; p++) {
+    g_job_queue[p] = channel_create_unbounded(sizeof(JobHandle *));
+    g_job_submitter[p] = unbounded_get_sender(g_job_queue[p]);
+    g_job_receiver[p] = unbounded_get_receiver(g_job_queue[p]);
+  }
+  atomic_store_explicit(&g_job_reserved, 0, memory_order_relaxed);
+
+  // deques per slot, a worker restarted in a slot inherits them
+  g_job_deques =
+      malloc(tp->num_workers * JOB_PRIORITY_COUNT * sizeof(WsDeque));
+  g_job_num_deques = tp->num_workers;
+  for (size_t i = 0; i < tp->num_workers * JOB_PRIORITY_COUNT; i++) {
+    ws_deque_init(&g_job_deques[i], JOB_SCHEDULER_LOCAL_CAPACITY);
   }
 
+  _threadpool_start(tp, num_threads);
+
   return tp;
 }
 
+// Pool backlog hook: queued jobs aren't counted, jobs alive are a close
+// upper bound.
+static size_t _job_backlog(ThreadPool *tp) {
+  (void)tp;
+  Scheduler *sche = g_scheduler;
+  return sche == NULL ? 0
+                      : atomic_load_explicit(&sche->active_jobs,
+                                             memory_order_relaxed);
+}
+
 static void *__set_worker_scheduler(void *arg) {
   Worker *worker = (Worker *)arg;
   JobHandle *job;
-  while (1) {
-    if (mpmc_recv(worker->receiver, &job) == CHANNEL_OK) {
-      assert(job != NULL);
-      assert(job->Job != NULL);
-
-      if (atomic_load_explicit(&job->unfinished, memory_order_acquire) == 1) {
-        // --> run job
-        job->Job(job->ctx);
-        atomic_fetch_add_explicit(&g_scheduler->jobs_completed_epoch, 1,
-                                  memory_order_release);
-        atomic_fetch_sub_explicit(&job->unfinished, 1, memory_order_release);
+  _threadpool_worker_setup(worker);
+  g_job_worker_id = (int64_t)worker->id;
+  while (_threadpool_worker_next(worker, &job, _job_worker_poll) ==
+         CHANNEL_OK) {
+    _job_execute(job);
+  }
 
-        if (job->continuation) {
-          atomic_fetch_sub_explicit(&job->continuation->unfinished, 1,
-                                    memory_order_release);
-          threadpool_schedule(worker->sender, job->continuation);
-        } else {
-          _job_scheduler_healthcheck();
-        }
+  // a retiring worker must not take its free handles with it
+  _job_cache_flush();
+#if defined(JOBSYSTEM_PROFILE)
+  _job_profile_release();
+#endif
+  g_job_worker_id = -1;
+  _threadpool_worker_exit(worker);
+  return NULL;
+};
 
-        atomic_fetch_sub_explicit(&g_scheduler->active_jobs, 1,
-                                  memory_order_acq_rel);
-      }
-    } else if (mpmc_is_closed(worker->chan_ref) == CLOSED) {
-      break;
+// Runs `job` if it is ready, jobs with unfinished parents are dropped (the
+// last parent schedules them again).
+static void _job_execute(JobHandle *job) {
+  assert(job != NULL);
+  assert(job->Job != NULL);
+
+  if (atomic_load_explicit(&job->unfinished, memory_order_acquire) == 1) {
+#if defined(JOBSYSTEM_FIBERS)
+    // resume a suspended job, or start it on a pooled fiber
+    JobFiber *fiber = job->fiber ? job->fiber : _job_fiber_acquire();
+    if (fiber) {
+      _job_fiber_resume(job, fiber);
+      return;
     }
+    // pool exhausted: run it on this stack, job_await falls back to job_join
+    JobFiber *outer_fiber = g_job_current_fiber;
+    g_job_current_fiber = NULL;
+#endif
+    // --> run job
+    uint8_t outer = g_job_current_priority;
+    g_job_current_priority = job->priority;
+#if defined(JOBSYSTEM_PROFILE)
+    uint64_t start_ns = _job_profile_now();
+#endif
+    job->Job(job->ctx);
+#if defined(JOBSYSTEM_PROFILE)
+    _job_profile_record(job, start_ns, _job_profile_now());
+#endif
+    g_job_current_priority = outer;
+#if defined(JOBSYSTEM_FIBERS)
+    g_job_current_fiber = outer_fiber;
+#endif
+    _job_finish(job);
+    return;
   }
+  _job_unref(job, 1);
+}
 
-  mpmc_close_sender(worker->sender);
-  mpmc_close_receiver(worker->receiver);
-  free(worker->receiver);
-  free(worker->sender);
-  free(worker);
-  return NULL;
-};
+// Completes a job that has run: releases its successors and drops the pending
+// run reference and the queue entry's.
+static void _job_finish(JobHandle *job) {
+  atomic_fetch_sub_explicit(&job->unfinished, 1, memory_order_release);
+
+  _job_release_successors(job);
+
+  atomic_fetch_sub_explicit(&g_scheduler->active_jobs, 1,
+                            memory_order_acq_rel);
+  _job_unref(job, 2);
+}
+
+#if defined(JOBSYSTEM_FIBERS)
+static void _job_fiber_pool_init(void) {
+  g_job_fiber_pool = channel_create_mpmc(JOB_FIBER_POOL_SIZE,
+                                         sizeof(JobFiber *));
+  // shared by every thread, mpmc_send / mpmc_try_recv only touch the channel
+  g_job_fiber_free = mpmc_get_sender(g_job_fiber_pool);
+  g_job_fiber_take = mpmc_get_receiver(g_job_fiber_pool);
+  atomic_store_explicit(&g_job_fibers_created, 0, memory_order_relaxed);
+}
+
+static void _job_fiber_pool_free(void) {
+  size_t created =
+      atomic_load_explicit(&g_job_fibers_created, memory_order_relaxed);
+  if (created > JOB_FIBER_POOL_SIZE) {
+    created = JOB_FIBER_POOL_SIZE;
+  }
+  for (size_t i = 0; i < created; i++) {
+    munmap(g_job_fibers[i]->stack, g_job_fibers[i]->stack_size);
+    free(g_job_fibers[i]);
+    g_job_fibers[i] = NULL;
+  }
+  mpmc_close(g_job_fiber_pool);
+  mpmc_close_sender(g_job_fiber_free);
+  mpmc_close_receiver(g_job_fiber_take);
+  free(g_job_fiber_free);
+  free(g_job_fiber_take);
+  mpmc_destroy(g_job_fiber_pool);
+  g_job_fiber_free = NULL;
+  g_job_fiber_take = NULL;
+  g_job_fiber_pool = NULL;
+}
+
+// An idle fiber, created on first use. NULL once JOB_FIBER_POOL_SIZE fibers
+// are busy (or suspended).
+static JobFiber *_job_fiber_acquire(void) {
+  JobFiber *fiber;
+  if (mpmc_try_recv(g_job_fiber_take, &fiber) == CHANNEL_OK) {
+    return fiber;
+  }
+  size_t slot =
+      atomic_fetch_add_explicit(&g_job_fibers_created, 1, memory_order_relaxed);
+  if (slot >= JOB_FIBER_POOL_SIZE) {
+    atomic_fetch_sub_explicit(&g_job_fibers_created, 1, memory_order_relaxed);
+    return NULL;
+  }
+
+  fiber = malloc(sizeof(JobFiber));
+  // the lowest page stays unmapped: an overflow faults instead of writing
+  // into the next stack
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  size_t size = ((JOB_FIBER_STACK_SIZE + page - 1) / page + 1) * page;
+  void *stack = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+  if (!fiber || stack == MAP_FAILED) {
+    free(fiber);
+    atomic_fetch_sub_explicit(&g_job_fibers_created, 1, memory_order_relaxed);
+    return NULL;
+  }
+  mprotect(stack, page, PROT_NONE);
+
+  fiber->stack = stack;
+  fiber->stack_size = size;
+  fiber->job = NULL;
+  fiber->await = NULL;
+  fiber->state = JOB_FIBER_RUNNING;
+  fiber->caller_rsp = NULL;
+  fiber->rsp = yield_make_context(stack, size, _job_fiber_main, fiber);
+  g_job_fibers[slot] = fiber;
+  return fiber;
+}
+
+// Queues a ready job on the shared queue of its priority, behind the jobs
+// already there (a suspended fiber must not be popped again right away).
+static void _job_requeue(JobHandle *job) {
+  job_retain(job);
+  if (unbounded_send(g_job_submitter[job->priority], &job) != CHANNEL_OK) {
+    _job_unref(job, 1);
+    return;
+  }
+  _job_notify(g_scheduler->threadpool, job->priority, 1);
+}
+
+// Switches to `fiber` until the job finishes or suspends, then completes,
+// parks or queues the job again. Runs on the resuming thread's stack.
+static void _job_fiber_resume(JobHandle *job, JobFiber *fiber) {
+  JobFiber *outer_fiber = g_job_current_fiber;
+  uint8_t outer = g_job_current_priority;
+  job->fiber = fiber;
+  fiber->job = job;
+  fiber->state = JOB_FIBER_RUNNING;
+  g_job_current_fiber = fiber;
+  g_job_current_priority = job->priority;
+#if defined(JOBSYSTEM_PROFILE)
+  uint64_t start_ns = _job_profile_now();
+#endif
+
+  yield_switch(&fiber->caller_rsp, fiber->rsp);
+
+#if defined(JOBSYSTEM_PROFILE)
+  // before the job is parked: once it is, another worker may resume it
+  _job_profile_record(job, start_ns, _job_profile_now());
+#endif
+  g_job_current_fiber = outer_fiber;
+  g_job_current_priority = outer;
+
+  switch (fiber->state) {
+  case JOB_FIBER_DONE:
+    job->fiber = NULL;
+    fiber->job = NULL;
+    mpmc_send(g_job_fiber_free, &fiber);
+    _job_finish(job);
+    return;
+  case JOB_FIBER_AWAIT:
+    // the fiber is off every stack now, the awaited job may resume it on
+    // any worker: hold it like a parent would
+    atomic_fetch_add_explicit(&job->unfinished, 1, memory_order_acq_rel);
+    if (_job_add_successor(fiber->await, job) != 0) {
+      // already finished, or out of memory: retry from the queue
+      atomic_fetch_sub_explicit(&job->unfinished, 1, memory_order_acq_rel);
+      _job_requeue(job);
+    }
+    break;
+  case JOB_FIBER_YIELD:
+  default:
+    _job_requeue(job);
+    break;
+  }
+  // the queue entry this run came from
+  _job_unref(job, 1);
+}
+
+// Entry of every pooled fiber: runs the job it was handed, switches back,
+// and starts over with the next job when it is reused.
+static void _job_fiber_main(void *arg) {
+  JobFiber *self = arg;
+  for (;;) {
+    JobHandle *job = self->job;
+    job->Job(job->ctx);
+    self->state = JOB_FIBER_DONE;
+    yield_switch(&self->rsp, self->caller_rsp);
+  }
+}
+
+// Thread-local reads stay in their own (not inlined) function: a fiber may
+// resume on another thread, a TLS address cached across a switch would point
+// to the previous thread's copy.
+static __attribute__((noinline)) JobFiber *_job_fiber_self(void) {
+  return g_job_current_fiber;
+}
+
+static __attribute__((noinline)) void
+_job_fiber_suspend(JobFiber *self, JobFiberState state, JobHandle *await) {
+  self->state = state;
+  self->await = await;
+  yield_switch(&self->rsp, self->caller_rsp);
+}
+#endif
+
+static int _job_worker_poll(Worker *worker, void *out) {
+  return _job_poll((int64_t)worker->id, (JobHandle **)out);
+}
+
+// Reserved slots, at most min_workers - 1: the pool never runs fewer than
+// min_workers, so one of them is always outside the reserved slots.
+static size_t _job_reserved(void) {
+  size_t reserved =
+      atomic_load_explicit(&g_job_reserved, memory_order_relaxed);
+  if (reserved == 0) {
+    return 0;
+  }
+  size_t min = atomic_load_explicit(&g_scheduler->threadpool->min_workers,
+                                    memory_order_relaxed);
+  if (reserved >= min) {
+    reserved = min > 0 ? min - 1 : 0;
+  }
+  return reserved;
+}
+
+// Lanes from the highest priority down. Workers in reserved slots and
+// threads outside the pool (helping in job_join) skip the background lane.
+// Returns CLOSED once every lane polled is closed and drained.
+static int _job_poll(int64_t self, JobHandle **out) {
+  int lanes = JOB_PRIORITY_COUNT;
+  if (self < 0 || (size_t)self < _job_reserved()) {
+    lanes = JOB_PRIORITY_BACKGROUND;
+  }
+
+  int res = CHANNEL_ERR_CLOSED;
+  for (int lane = 0; lane < lanes; lane++) {
+    int r = _job_poll_lane(self, lane, out);
+    if (r == CHANNEL_OK) {
+      return r;
+    }
+    if (r != CHANNEL_ERR_CLOSED) {
+      res = r;
+    }
+  }
+  return res;
+}
 
-static void threadpool_schedule(SenderMpmc *sender, JobHandle *scheduled_job) {
+// Own deque first (LIFO), then external submissions, then steal (FIFO) from
+// the other workers starting after our own index. `self` is -1 for threads
+// outside the pool.
+static int _job_poll_lane(int64_t self, int lane, JobHandle **out) {
+  void *item;
+  if (self >= 0 &&
+      ws_deque_pop(_job_deque(self, lane), &item) == WS_DEQUE_OK) {
+    *out = item;
+    return CHANNEL_OK;
+  }
+
+  int res = unbounded_try_recv(g_job_receiver[lane], out);
+  if (res == CHANNEL_OK) {
+    return res;
+  }
+
+  size_t start = self >= 0 ? (size_t)self : 0;
+  for (size_t i = self >= 0 ? 1 : 0; i < g_job_num_deques; i++) {
+    size_t victim = (start + i) % g_job_num_deques;
+    if (ws_deque_steal(_job_deque(victim, lane), &item) == WS_DEQUE_OK) {
+      *out = item;
+      return CHANNEL_OK;
+    }
+  }
+  // CLOSED only once the channel is drained, jobs left in other deques are
+  // finished by their owners before they exit
+  return res;
+}
+
+// Runs one pending job on the calling thread, worker or not. Returns 1 if a
+// job was taken.
+static int _job_help_one(void) {
+  JobHandle *job;
+  if (_job_poll(g_job_worker_id, &job) != CHANNEL_OK) {
+    return 0;
+  }
+  _job_execute(job);
+  return 1;
+}
+
+// Runs pending jobs on the calling thread until `counter` drops to 0.
+static void _job_help_while(_Atomic size_t *counter) {
+  while (atomic_load_explicit(counter, memory_order_acquire) != 0) {
+    if (!_job_help_one()) {
+      cpu_relax();
+    }
+  }
+}
+
+// Wakes parked workers for `n` jobs queued on `lane`. Reserved workers
+// skip the background lane and park again, a background job wakes every
+// worker so one that may run it isn't left asleep.
+static void _job_notify(ThreadPool *tp, uint8_t lane, size_t n) {
+  if (lane == JOB_PRIORITY_BACKGROUND && _job_reserved() > 0) {
+    channel_signal_notify(&tp->idle);
+    return;
+  }
+  channel_signal_notify_n(&tp->idle, (uint32_t)(n > UINT32_MAX ? UINT32_MAX
+                                                                : n));
+}
+
+static void threadpool_schedule(JobHandle *scheduled_job) {
   if (atomic_load_explicit(&scheduled_job->unfinished, memory_order_acquire) ==
       0) {
     return;
   }
-  mpmc_send(sender, &scheduled_job);
+  ThreadPool *tp = g_scheduler->threadpool;
+  size_t backlog;
+  // the queue entry holds a reference, dropped once it is taken
+  job_retain(scheduled_job);
+  // scheduled from inside a job: keep it on this worker, others may steal it
+  uint8_t lane = scheduled_job->priority;
+  if (g_job_worker_id >= 0 &&
+      ws_deque_push(_job_deque(g_job_worker_id, lane), scheduled_job) ==
+          WS_DEQUE_OK) {
+    backlog = ws_deque_size(_job_deque(g_job_worker_id, lane));
+  } else {
+    if (unbounded_send(g_job_submitter[lane], &scheduled_job) !=
+        CHANNEL_OK) {
+      // closed (shutdown) or out of memory
+      _job_unref(scheduled_job, 1);
+      return;
+    }
+    backlog = _job_backlog(tp);
+  }
+  _job_notify(tp, lane, 1);
+  _threadpool_maybe_grow(tp, backlog);
 };
 
-static void _job_scheduler_reset(void);
+// Appends `job` to the successors of `parent`, past JOB_MAX_SUCCESSORS on
+// its overflow list. Returns 0, 1 if `parent` has already finished (nothing
+// to wait for) or -1 if out of memory.
+static int _job_add_successor(JobHandle *parent, JobHandle *job) {
+  uint32_t n =
+      atomic_load_explicit(&parent->num_successors, memory_order_acquire);
+  do {
+    if (n & JOB_SUCCESSORS_SEALED) {
+      return 1;
+    }
+    if (n >= JOB_MAX_SUCCESSORS) {
+      return _job_add_overflow(parent, job);
+    }
+  } while (!atomic_compare_exchange_weak_explicit(
+      &parent->num_successors, &n, n + 1, memory_order_acq_rel,
+      memory_order_acquire));
+
+  atomic_store_explicit(&parent->successors[n], job, memory_order_release);
+  return 0;
+}
+
+// Pushes `job` on the overflow list of `parent`, unless the list has been
+// sealed already. Same returns as _job_add_successor.
+static int _job_add_overflow(JobHandle *parent, JobHandle *job) {
+  JobSuccessorNode *node = malloc(sizeof(JobSuccessorNode));
+  if (!node) {
+    return -1;
+  }
+  node->job = job;
+  JobSuccessorNode *head =
+      atomic_load_explicit(&parent->overflow, memory_order_acquire);
+  do {
+    if (head == JOB_OVERFLOW_SEALED) {
+      free(node);
+      return 1;
+    }
+    node->next = head;
+  } while (!atomic_compare_exchange_weak_explicit(
+      &parent->overflow, &head, node, memory_order_release,
+      memory_order_acquire));
+  return 0;
+}
+
+static void _job_release_one(JobHandle *next) {
+  if (atomic_fetch_sub_explicit(&next->unfinished, 1, memory_order_acq_rel) ==
+      2) {
+    threadpool_schedule(next);
+  }
+}
+
+// Seals the successor list of a finished job and schedules every successor
+// whose last unfinished parent was `job`. Returns the number of successors.
+static size_t _job_release_successors(JobHandle *job) {
+  uint32_t n = atomic_fetch_or_explicit(&job->num_successors,
+                                        JOB_SUCCESSORS_SEALED,
+                                        memory_order_acq_rel);
+  for (uint32_t i = 0; i < n; i++) {
+    JobHandle *next;
+    // slot reserved by a concurrent _job_add_successor, not yet stored
+    while ((next = atomic_load_explicit(&job->successors[i],
+                                        memory_order_acquire)) == NULL) {
+      cpu_relax();
+    }
+    _job_release_one(next);
+  }
+
+  // adders that found the inline slots full push here until this seals it
+  size_t released = n;
+  JobSuccessorNode *node = atomic_exchange_explicit(
+      &job->overflow, JOB_OVERFLOW_SEALED, memory_order_acq_rel);
+  while (node != NULL) {
+    JobSuccessorNode *next = node->next;
+    _job_release_one(node->job);
+    free(node);
+    released++;
+    node = next;
+  }
+  return released;
+}
 
-static void _job_scheduler_healthcheck(void) {
-  if (atomic_load_explicit(&g_scheduler->jobs_completed_epoch,
-                           memory_order_acquire) >
-      JOB_SCHEDULER_MAX_JOBS - 20) {
-    _job_scheduler_reset();
+static JobHandleCache *_job_cache(void) {
+  JobHandleCache *cache = &g_job_cache;
+  if (cache->generation != g_job_generation) {
+    cache->head = NULL;
+    cache->tail = NULL;
+    cache->count = 0;
+    cache->generation = g_job_generation;
   }
+  return cache;
 }
 
-static void _job_scheduler_reset(void) {
-  atomic_store_explicit(&g_scheduler->accepting_jobs, 0, memory_order_release);
+// Free handle from this thread's cache, the shared free list, then the arena.
+static JobHandle *_job_alloc(void) {
+  JobHandleCache *cache = _job_cache();
+
+  if (!cache->head) {
+    // taking the whole list at once avoids the ABA problem of a CAS pop
+    JobHandle *list = atomic_exchange_explicit(&g_scheduler->free_handles,
+                                               NULL, memory_order_acquire);
+    for (JobHandle *it = list; it; it = it->next_free) {
+      if (!cache->head) {
+        cache->head = it;
+      }
+      cache->tail = it;
+      cache->count++;
+    }
+  }
 
-  while (atomic_load_explicit(&g_scheduler->active_jobs,
-                              memory_order_acquire) != 0) {
-    cpu_relax();
+  JobHandle *job = cache->head;
+  if (job) {
+    cache->head = job->next_free;
+    if (!cache->head) {
+      cache->tail = NULL;
+    }
+    cache->count--;
+    return job;
   }
-  r_arena_reset(&g_scheduler->job_arena);
-  atomic_store_explicit(&g_scheduler->jobs_completed_epoch, 0,
-                        memory_order_release);
+  return (JobHandle *)r_arena_alloc(&g_scheduler->job_arena);
+}
 
-  atomic_store_explicit(&g_scheduler->accepting_jobs, 1, memory_order_release);
+// Drops `n` references, the last one returns the handle to this thread's
+// cache.
+static void _job_unref(JobHandle *job, size_t n) {
+  if (atomic_fetch_sub_explicit(&job->refs, n, memory_order_acq_rel) != n) {
+    return;
+  }
+  if (job->owns_ctx) {
+    free(job->ctx);
+    job->owns_ctx = 0;
+  }
+  JobHandleCache *cache = _job_cache();
+
+  job->next_free = cache->head;
+  cache->head = job;
+  if (!cache->tail) {
+    cache->tail = job;
+  }
+  if (++cache->count > JOB_HANDLE_CACHE_SIZE) {
+    _job_cache_flush();
+  }
+}
+
+// Moves this thread's cache to the shared free list (workers free most
+// handles, threads outside the pool spawn most of them).
+static void _job_cache_flush(void) {
+  JobHandleCache *cache = _job_cache();
+  if (!cache->head) {
+    return;
+  }
+  JobHandle *head =
+      atomic_load_explicit(&g_scheduler->free_handles, memory_order_relaxed);
+  do {
+    cache->tail->next_free = head;
+  } while (!atomic_compare_exchange_weak_explicit(
+      &g_scheduler->free_handles, &head, cache->head, memory_order_release,
+      memory_order_relaxed));
+  cache->head = NULL;
+  cache->tail = NULL;
+  cache->count = 0;
+}
+
+#if defined(JOBSYSTEM_PROFILE)
+static uint64_t _job_profile_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// This thread's ring, on its first event. A worker continues the ring its
+// slot's previous worker left, other threads get a new one. Rings of a
+// previous scheduler instance were freed by its shutdown.
+static JobProfileRing *_job_profile_ring(void) {
+  if (g_job_profile_ring && g_job_profile_generation == g_job_generation) {
+    return g_job_profile_ring;
+  }
+  g_job_profile_generation = g_job_generation;
+  if (g_job_worker_id >= 0) {
+    JobProfileRing *ring =
+        atomic_load_explicit(&g_job_profile_rings, memory_order_acquire);
+    for (; ring; ring = ring->next) {
+      uint8_t expected = 0;
+      if (ring->worker == (int32_t)g_job_worker_id &&
+          atomic_compare_exchange_strong_explicit(&ring->owned, &expected, 1,
+                                                  memory_order_acquire,
+                                                  memory_order_relaxed)) {
+        g_job_profile_ring = ring;
+        return ring;
+      }
+    }
+  }
+
+  JobProfileRing *ring = malloc(sizeof(JobProfileRing));
+  if (!ring) {
+    g_job_profile_ring = NULL;
+    return NULL;
+  }
+  atomic_init(&ring->head, 0);
+  atomic_init(&ring->cleared, 0);
+  ring->id = atomic_fetch_add_explicit(&g_job_profile_next_id, 1,
+                                       memory_order_relaxed);
+  ring->worker = (int32_t)g_job_worker_id;
+  atomic_init(&ring->owned, 1);
+  ring->next =
+      atomic_load_explicit(&g_job_profile_rings, memory_order_relaxed);
+  while (!atomic_compare_exchange_weak_explicit(
+      &g_job_profile_rings, &ring->next, ring, memory_order_release,
+      memory_order_relaxed)) {
+  }
+  g_job_profile_ring = ring;
+  return ring;
+}
+
+// Hands this worker's ring back before its thread exits, the next worker
+// started in the slot continues it.
+static void _job_profile_release(void) {
+  if (g_job_profile_ring && g_job_profile_generation == g_job_generation) {
+    // publishes the events recorded here to the next owner
+    atomic_store_explicit(&g_job_profile_ring->owned, 0, memory_order_release);
+  }
+  g_job_profile_ring = NULL;
+}
+
+static void _job_profile_record(JobHandle *job, uint64_t start_ns,
+                                uint64_t end_ns) {
+  JobProfileRing *ring = _job_profile_ring();
+  if (!ring) {
+    return;
+  }
+  uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  JobProfileEvent *ev = &ring->events[head % JOB_PROFILE_RING_SIZE];
+  ev->label = job->label;
+  ev->fn = job->Job;
+  ev->spawn_ns = job->spawn_ns;
+  ev->start_ns = start_ns;
+  ev->end_ns = end_ns;
+  ev->worker = (int32_t)g_job_worker_id;
+  ev->priority = job->priority;
+  job->spawn_ns = 0;
+  // publishes the event to job_profile_export_chrome
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+static void _job_profile_free(void) {
+  JobProfileRing *ring =
+      atomic_exchange_explicit(&g_job_profile_rings, NULL, memory_order_acquire);
+  while (ring) {
+    JobProfileRing *next = ring->next;
+    free(ring);
+    ring = next;
+  }
+  atomic_store_explicit(&g_job_profile_next_id, 0, memory_order_relaxed);
+}
+
+static void _job_profile_write_str(FILE *f, const char *str) {
+  fputc('"', f);
+  for (; *str; str++) {
+    if (*str == '"' || *str == '\\') {
+      fputc('\\', f);
+    }
+    if ((unsigned char)*str >= 0x20) {
+      fputc(*str, f);
+    }
+  }
+  fputc('"', f);
+}
+#endif
+
+void job_profile_clear(void) {
+#if defined(JOBSYSTEM_PROFILE)
+  JobProfileRing *ring =
+      atomic_load_explicit(&g_job_profile_rings, memory_order_acquire);
+  for (; ring; ring = ring->next) {
+    atomic_store_explicit(
+        &ring->cleared, atomic_load_explicit(&ring->head, memory_order_acquire),
+        memory_order_relaxed);
+  }
+#endif
+}
+
+// Chrome trace event format (chrome://tracing, ui.perfetto.dev): one "X"
+// event per run slice, one track per thread, timestamps in microseconds.
+int job_profile_export_chrome(const char *path) {
+#if defined(JOBSYSTEM_PROFILE)
+  static const char *priority_names[JOB_PRIORITY_COUNT] = {
+      "critical", "normal", "background"};
+  FILE *f = fopen(path, "w");
+  if (!f) {
+    return -1;
+  }
+  JobProfileEvent *copy = malloc(sizeof(JobProfileEvent) * JOB_PROFILE_RING_SIZE);
+  if (!copy) {
+    fclose(f);
+    return -1;
+  }
+
+  fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  int first = 1;
+  JobProfileRing *ring =
+      atomic_load_explicit(&g_job_profile_rings, memory_order_acquire);
+  for (; ring; ring = ring->next) {
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint64_t lo = head > JOB_PROFILE_RING_SIZE ? head - JOB_PROFILE_RING_SIZE
+                                               : 0;
+    uint64_t cleared =
+        atomic_load_explicit(&ring->cleared, memory_order_relaxed);
+    if (lo < cleared) {
+      lo = cleared;
+    }
+    for (uint64_t i = lo; i < head; i++) {
+      copy[i - lo] = ring->events[i % JOB_PROFILE_RING_SIZE];
+    }
+    // the owner kept recording meanwhile: drop the slots it may have
+    // overwritten (including the one it is writing)
+    uint64_t now_head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint64_t valid = now_head >= JOB_PROFILE_RING_SIZE
+                         ? now_head - JOB_PROFILE_RING_SIZE + 1
+                         : 0;
+
+    char name[32];
+    if (ring->worker >= 0) {
+      snprintf(name, sizeof(name), "worker-%d", (int)ring->worker);
+    } else {
+      snprintf(name, sizeof(name), "thread-%u", (unsigned)ring->id);
+    }
+    fprintf(f,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",\n", (unsigned)ring->id, name);
+    first = 0;
+
+    for (uint64_t i = lo > valid ? lo : valid; i < head; i++) {
+      JobProfileEvent *ev = &copy[i - lo];
+      fprintf(f, ",\n{\"name\":");
+      if (ev->label) {
+        _job_profile_write_str(f, ev->label);
+      } else {
+        fprintf(f, "\"job %p\"", *(void **)&ev->fn);
+      }
+      fprintf(f,
+              ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+              "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"worker\":%d",
+              priority_names[ev->priority % JOB_PRIORITY_COUNT],
+              (unsigned)ring->id, (double)ev->start_ns / 1000.0,
+              (double)(ev->end_ns - ev->start_ns) / 1000.0, (int)ev->worker);
+      if (ev->spawn_ns) {
+        fprintf(f, ",\"queue_us\":%.3f",
+                (double)(ev->start_ns - ev->spawn_ns) / 1000.0);
+      }
+      fprintf(f, "}}");
+    }
+  }
+  fprintf(f, "\n]}\n");
+
+  free(copy);
+  int res = ferror(f) ? -1 : 0;
+  if (fclose(f) != 0) {
+    res = -1;
+  }
+  return res;
+#else
+  (void)path;
+  return -1;
+#endif
 }
 #endif
@@ -0,0 +1,387 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define CHANNEL_BASICS_IMPLEMENTATION
+#include "../channels/channels.h"
+#define SPSC_IMPLEMENTATION
+#include "../channels/spsc.h"
+#define MPSC_IMPLEMENTATION
+#include "../channels/mpsc.h"
+#define MCAST_IMPLEMENTATION
+#include "../channels/mcast.h"
+#define UNBOUNDED_IMPLEMENTATION
+#include "../channels/unbounded.h"
+
+/*
+ * Channel tests
+ * -----------------------------
+ * Edge cases of the channel protocols (close, chaining, reserve / peek, batches),
+ * one function per case. Prints every failed check, exits 1 if any failed.
+ *
+ *   make test-channels
+ * */
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: %s: check failed: %s\n", __FILE__, __LINE__,    \
+              __func__, #cond);                                                \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+/*---------------- spsc ----------------*/
+
+// a send can't take the slot a pending reservation owns
+static void test_spsc_send_while_reserved(void) {
+  ChannelSpsc *chan = channel_create_spsc(4, sizeof(int));
+  SenderSpsc *sender = spsc_get_sender(chan);
+  ReceiverSpsc *receiver = spsc_get_receiver(chan);
+
+  int *slot;
+  int value = 2;
+  CHECK(spsc_try_reserve(sender, (void **)&slot) == CHANNEL_OK);
+  *slot = 1;
+  CHECK(spsc_try_send(sender, &value) == CHANNEL_ERR_FULL);
+  CHECK(spsc_commit(sender) == CHANNEL_OK);
+  CHECK(spsc_try_send(sender, &value) == CHANNEL_OK);
+
+  CHECK(spsc_recv(receiver, &value) == CHANNEL_OK && value == 1);
+  CHECK(spsc_recv(receiver, &value) == CHANNEL_OK && value == 2);
+  CHECK(spsc_recv(receiver, &value) == CHANNEL_ERR_EMPTY);
+
+  free(sender);
+  free(receiver);
+  spsc_destroy(chan);
+}
+
+// recv and a second peek leave a pending peek alone
+static void test_spsc_recv_while_peeked(void) {
+  ChannelSpsc *chan = channel_create_spsc(4, sizeof(int));
+  SenderSpsc *sender = spsc_get_sender(chan);
+  ReceiverSpsc *receiver = spsc_get_receiver(chan);
+
+  for (int i = 0; i < 3; i++) {
+    CHECK(spsc_try_send(sender, &i) == CHANNEL_OK);
+  }
+  int *slot;
+  int value;
+  CHECK(spsc_peek(receiver, (void **)&slot) == CHANNEL_OK && *slot == 0);
+  CHECK(spsc_recv(receiver, &value) == CHANNEL_ERR_EMPTY);
+  CHECK(spsc_peek(receiver, (void **)&slot) == CHANNEL_ERR_FULL);
+  CHECK(spsc_release(receiver) == CHANNEL_OK);
+
+  CHECK(spsc_recv(receiver, &value) == CHANNEL_OK && value == 1);
+  CHECK(spsc_recv(receiver, &value) == CHANNEL_OK && value == 2);
+  CHECK(spsc_recv(receiver, &value) == CHANNEL_ERR_EMPTY);
+
+  free(sender);
+  free(receiver);
+  spsc_destroy(chan);
+}
+
+/*---------------- mpsc ----------------*/
+
+// recv and a second peek leave a pending peek alone, the ring stays in order
+// across the wrap
+static void test_mpsc_recv_while_peeked(void) {
+  ChannelMpsc *chan = channel_create_mpsc(4, sizeof(int));
+  SenderMpsc *sender = mpsc_get_sender(chan);
+  ReceiverMpsc *receiver = mpsc_get_receiver(chan);
+
+  int next = 0;
+  int expected = 0;
+  for (int round = 0; round < 4; round++) {
+    for (int i = 0; i < 3; i++, next++) {
+      CHECK(mpsc_send(sender, &next) == CHANNEL_OK);
+    }
+    int *slot;
+    int value;
+    CHECK(mpsc_peek(receiver, (void **)&slot) == CHANNEL_OK &&
+          *slot == expected);
+    CHECK(mpsc_recv(receiver, &value) == CHANNEL_ERR_EMPTY);
+    CHECK(mpsc_peek(receiver, (void **)&slot) == CHANNEL_ERR_FULL);
+    CHECK(mpsc_release(receiver) == CHANNEL_OK);
+    expected++;
+    while (mpsc_recv(receiver, &value) == CHANNEL_OK) {
+      CHECK(value == expected);
+      expected++;
+    }
+  }
+  CHECK(expected == next);
+
+  mpsc_close_sender(sender);
+  free(sender);
+  free(receiver);
+  mpsc_destroy(chan);
+}
+
+/*---------------- mcast ----------------*/
+
+#define MCAST_IN_FLIGHT 10
+
+// elements sent before close still reach a receiver chained after one that
+// hasn't read them yet
+static void test_mcast_close_in_flight_chain(void) {
+  ChannelMcast *chan = channel_create_mcast(16, sizeof(int), 2);
+  ReceiverMcast *upstream = mcast_get_receiver(chan, NULL, 0);
+  ReceiverMcast *downstream = mcast_get_receiver(chan, &upstream, 1);
+  SenderMcast *sender = mcast_get_sender(chan);
+
+  for (int i = 0; i < MCAST_IN_FLIGHT; i++) {
+    CHECK(mcast_send(sender, &i) == CHANNEL_OK);
+  }
+  mcast_close(chan);
+
+  int value;
+  // published, only upstream is behind: not the end of the stream
+  CHECK(mcast_try_recv(downstream, &value) == CHANNEL_ERR_EMPTY);
+
+  for (int i = 0; i < MCAST_IN_FLIGHT; i++) {
+    CHECK(mcast_recv(upstream, &value) == CHANNEL_OK && value == i);
+  }
+  CHECK(mcast_recv(upstream, &value) == CHANNEL_ERR_CLOSED);
+
+  for (int i = 0; i < MCAST_IN_FLIGHT; i++) {
+    CHECK(mcast_recv(downstream, &value) == CHANNEL_OK && value == i);
+  }
+  CHECK(mcast_recv(downstream, &value) == CHANNEL_ERR_CLOSED);
+
+  mcast_close_sender(sender);
+  mcast_close_receiver(downstream);
+  mcast_close_receiver(upstream);
+  free(sender);
+  free(downstream);
+  free(upstream);
+  mcast_destroy(chan);
+}
+
+static void *mcast_slow_upstream(void *arg) {
+  ReceiverMcast *upstream = arg;
+  int value;
+  usleep(10000);
+  while (mcast_recv(upstream, &value) == CHANNEL_OK) {
+    usleep(100);
+  }
+  return NULL;
+}
+
+// a blocking downstream recv waits for upstream instead of seeing the close
+static void test_mcast_close_in_flight_chain_blocking(void) {
+  ChannelMcast *chan = channel_create_mcast(16, sizeof(int), 2);
+  ReceiverMcast *upstream = mcast_get_receiver(chan, NULL, 0);
+  ReceiverMcast *downstream = mcast_get_receiver(chan, &upstream, 1);
+  SenderMcast *sender = mcast_get_sender(chan);
+
+  for (int i = 0; i < MCAST_IN_FLIGHT; i++) {
+    CHECK(mcast_send(sender, &i) == CHANNEL_OK);
+  }
+  mcast_close(chan);
+
+  pthread_t thread;
+  pthread_create(&thread, NULL, mcast_slow_upstream, upstream);
+  int value;
+  int received = 0;
+  while (mcast_recv(downstream, &value) == CHANNEL_OK) {
+    CHECK(value == received);
+    received++;
+  }
+  CHECK(received == MCAST_IN_FLIGHT);
+  pthread_join(thread, NULL);
+
+  mcast_close_sender(sender);
+  mcast_close_receiver(downstream);
+  mcast_close_receiver(upstream);
+  free(sender);
+  free(downstream);
+  free(upstream);
+  mcast_destroy(chan);
+}
+
+// a detached upstream releases the elements it never read
+static void test_mcast_close_upstream_detached(void) {
+  ChannelMcast *chan = channel_create_mcast(16, sizeof(int), 2);
+  ReceiverMcast *upstream = mcast_get_receiver(chan, NULL, 0);
+  ReceiverMcast *downstream = mcast_get_receiver(chan, &upstream, 1);
+  SenderMcast *sender = mcast_get_sender(chan);
+
+  for (int i = 0; i < MCAST_IN_FLIGHT; i++) {
+    CHECK(mcast_send(sender, &i) == CHANNEL_OK);
+  }
+  mcast_close(chan);
+  mcast_close_receiver(upstream);
+
+  int value;
+  int received = 0;
+  while (mcast_recv(downstream, &value) == CHANNEL_OK) {
+    received++;
+  }
+  CHECK(received == MCAST_IN_FLIGHT);
+
+  mcast_close_sender(sender);
+  mcast_close_receiver(downstream);
+  free(sender);
+  free(downstream);
+  free(upstream);
+  mcast_destroy(chan);
+}
+
+// recv and a second peek leave a pending peek alone
+static void test_mcast_recv_while_peeked(void) {
+  ChannelMcast *chan = channel_create_mcast(4, sizeof(int), 1);
+  ReceiverMcast *receiver = mcast_get_receiver(chan, NULL, 0);
+  SenderMcast *sender = mcast_get_sender(chan);
+
+  for (int i = 0; i < 3; i++) {
+    CHECK(mcast_send(sender, &i) == CHANNEL_OK);
+  }
+  int *slot;
+  int value;
+  CHECK(mcast_peek(receiver, (void **)&slot) == CHANNEL_OK && *slot == 0);
+  CHECK(mcast_try_recv(receiver, &value) == CHANNEL_ERR_EMPTY);
+  CHECK(mcast_recv(receiver, &value) == CHANNEL_ERR_EMPTY);
+  CHECK(mcast_peek(receiver, (void **)&slot) == CHANNEL_ERR_FULL);
+  CHECK(mcast_release(receiver) == CHANNEL_OK);
+
+  CHECK(mcast_try_recv(receiver, &value) == CHANNEL_OK && value == 1);
+  CHECK(mcast_try_recv(receiver, &value) == CHANNEL_OK && value == 2);
+  CHECK(mcast_try_recv(receiver, &value) == CHANNEL_ERR_EMPTY);
+
+  mcast_close_sender(sender);
+  mcast_close_receiver(receiver);
+  free(sender);
+  free(receiver);
+  mcast_destroy(chan);
+}
+
+/*---------------- unbounded ----------------*/
+
+#define BATCH_PRODUCERS 4
+#define BATCH_PER_PRODUCER 20000
+
+static ChannelUnbounded *batch_chan;
+
+// producer id in the high bits, index in the low bits
+static void *unbounded_batch_producer(void *arg) {
+  uint64_t id = (uint64_t)(uintptr_t)arg;
+  SenderUnbounded *sender = unbounded_get_sender(batch_chan);
+  uint64_t batch[3 * UNBOUNDED_SEGMENT_CAPACITY];
+  uint64_t done = 0;
+  size_t step = 0;
+  while (done < BATCH_PER_PRODUCER) {
+    // odd sizes, up to three segments long
+    size_t count = 1 + (step++ * 13) % (3 * UNBOUNDED_SEGMENT_CAPACITY);
+    if (count > BATCH_PER_PRODUCER - done) {
+      count = BATCH_PER_PRODUCER - done;
+    }
+    for (size_t i = 0; i < count; i++) {
+      batch[i] = (id << 32) | (done + i);
+    }
+    size_t sent;
+    CHECK(unbounded_send_batch(sender, batch, count, &sent) == CHANNEL_OK);
+    CHECK(sent == count);
+    done += count;
+  }
+  unbounded_close_sender(sender);
+  free(sender);
+  return NULL;
+}
+
+// a batch crossing segments comes out whole and in order
+static void test_unbounded_send_batch_segments(void) {
+  ChannelUnbounded *chan = channel_create_unbounded(sizeof(int));
+  SenderUnbounded *sender = unbounded_get_sender(chan);
+  ReceiverUnbounded *receiver = unbounded_get_receiver(chan);
+
+  int batch[3 * UNBOUNDED_SEGMENT_CAPACITY + 5];
+  size_t count = sizeof(batch) / sizeof(batch[0]);
+  for (size_t i = 0; i < count; i++) {
+    batch[i] = (int)i;
+  }
+  size_t sent;
+  int value = -1;
+  CHECK(unbounded_send(sender, &value) == CHANNEL_OK);
+  CHECK(unbounded_send_batch(sender, batch, count, &sent) == CHANNEL_OK);
+  CHECK(sent == count);
+  CHECK(unbounded_send_batch(sender, batch, 0, &sent) == CHANNEL_OK);
+  CHECK(sent == 0);
+
+  CHECK(unbounded_try_recv(receiver, &value) == CHANNEL_OK && value == -1);
+  for (size_t i = 0; i < count; i++) {
+    CHECK(unbounded_try_recv(receiver, &value) == CHANNEL_OK &&
+          value == (int)i);
+  }
+  CHECK(unbounded_try_recv(receiver, &value) == CHANNEL_ERR_EMPTY);
+
+  unbounded_close(chan);
+  CHECK(unbounded_send_batch(sender, batch, count, &sent) ==
+        CHANNEL_ERR_CLOSED);
+  CHECK(sent == 0);
+
+  unbounded_close_sender(sender);
+  unbounded_close_receiver(receiver);
+  free(sender);
+  free(receiver);
+  unbounded_destroy(chan);
+}
+
+// concurrent batches: nothing lost, each producer's order kept
+static void test_unbounded_send_batch_producers(void) {
+  batch_chan = channel_create_unbounded(sizeof(uint64_t));
+  ReceiverUnbounded *receiver = unbounded_get_receiver(batch_chan);
+
+  pthread_t producers[BATCH_PRODUCERS];
+  for (uintptr_t i = 0; i < BATCH_PRODUCERS; i++) {
+    pthread_create(&producers[i], NULL, unbounded_batch_producer, (void *)i);
+  }
+
+  uint64_t expected[BATCH_PRODUCERS] = {0};
+  uint64_t value;
+  size_t received = 0;
+  while (received < BATCH_PRODUCERS * BATCH_PER_PRODUCER &&
+         unbounded_recv(receiver, &value) == CHANNEL_OK) {
+    uint64_t id = value >> 32;
+    CHECK(id < BATCH_PRODUCERS);
+    if (id < BATCH_PRODUCERS) {
+      CHECK((value & 0xffffffffu) == expected[id]);
+      expected[id] = (value & 0xffffffffu) + 1;
+    }
+    received++;
+  }
+  CHECK(received == BATCH_PRODUCERS * BATCH_PER_PRODUCER);
+
+  for (int i = 0; i < BATCH_PRODUCERS; i++) {
+    pthread_join(producers[i], NULL);
+  }
+  unbounded_close(batch_chan);
+  CHECK(unbounded_recv(receiver, &value) == CHANNEL_ERR_CLOSED);
+
+  unbounded_close_receiver(receiver);
+  free(receiver);
+  unbounded_destroy(batch_chan);
+}
+
+int main(void) {
+  test_spsc_send_while_reserved();
+  test_spsc_recv_while_peeked();
+  test_mpsc_recv_while_peeked();
+  test_mcast_close_in_flight_chain();
+  test_mcast_close_in_flight_chain_blocking();
+  test_mcast_close_upstream_detached();
+  test_mcast_recv_while_peeked();
+  test_unbounded_send_batch_segments();
+  test_unbounded_send_batch_producers();
+
+  if (failures > 0) {
+    fprintf(stderr, "%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("channels: all tests passed\n");
+  return 0;
+}
@@ -23,7 +23,7 @@
 threadpool.h — Minimal Multi-Threaded Job Executor
 
 This thread pool implementation allows submitting arbitrary jobs (functions with
-a single void* argument) to a fixed pool of worker threads. The job dispatching
+a single void* argument) to a pool of worker threads. The job dispatching
 is lock-free and uses a Multi-Producer Multi-Consumer (MPMC) channel for
 queueing.
 
@@ -40,13 +40,44 @@ Worker:
   - receiver : channel receiver to get jobs
   - sender   : channel sender to propagate jobs if needed
   - chan_ref : reference to the shared MPMC channel
+  - idle     : pool signal the worker parks on when there is no work
+  - pool     : owning pool
+  - place    : CPU / NUMA node / thread name applied at start-up
+  - id       : slot of the worker inside its pool
 
 ThreadPool:
   Represents the pool itself.
-  - workers     : array of pthread_t for each thread
-  - num_workers : number of threads in the pool
-  - channel     : shared MPMC channel used for job dispatch
+  - workers     : array of pthread_t, one per worker slot
+  - num_workers : number of worker slots (the largest size the pool reaches)
+  - channel     : shared MPMC channel used for job dispatch (NULL for pools
+                  whose workers take work elsewhere, like the job system)
+  - queue_capacity : capacity of `channel`
   - dispatcher  : sender handle used to submit jobs
+  - idle        : signal idle workers sleep on (see IDLE PARKING)
+  - slot_state  : FREE / LIVE / EXITED for each slot
+  - placement   : WorkerPlacement for each slot
+  - backlog     : returns how much work is queued, workers use it to grow
+                  the pool (channel length by default, the job system
+                  installs its own since its pool has no channel)
+  - min_workers, max_workers : current sizing bounds (see ELASTIC SIZING)
+  - live_workers : running workers
+  - idle_workers : workers currently parked
+
+ThreadPoolOptions:
+  Placement options for threadpool_init_ex (zero-initialise, then set).
+  - cpus        : explicit CPU list, worker i runs on cpus[i % num_cpus]
+  - num_cpus    : length of `cpus`
+  - pin         : pin workers to CPUs picked from the topology (ignored
+                  when `cpus` is set, which always pins)
+  - avoid_smt   : when picking CPUs, use one hardware thread per core
+  - exclude     : CPUs never picked (e.g. reserved for the input thread)
+  - num_exclude : length of `exclude`
+  - numa_local  : workers prefer memory from their CPU's NUMA node
+  - name        : thread name prefix, workers are named "<name>-<i>"
+  - min_threads : elastic lower bound (0 = num_threads, pool never shrinks)
+  - max_threads : elastic upper bound (0 = num_threads, pool never grows)
+  - idle_timeout_ms : how long a worker above min_threads stays parked
+                  before it exits (0 = THREADPOOL_IDLE_TIMEOUT_MS)
 
 ------------------------------------------------------------------------------
 FUNCTIONS
@@ -63,6 +94,22 @@ threadpool_init
     - Spawns num_threads worker threads.
     - Each worker listens for jobs via the channel.
     - The thread pool is ready to execute jobs immediately.
+    - Same as threadpool_init_ex(num_threads, NULL).
+
+threadpool_init_ex
+  Same as threadpool_init, with worker placement and naming.
+
+  num_threads : number of worker threads
+  opts        : placement options, NULL for unpinned anonymous workers
+
+  Notes:
+    - The CPU topology is read from /sys (see topology.h).
+    - Each worker applies its placement itself before taking jobs, so
+      allocations made inside jobs land on the worker's node.
+    - If pinning fails (e.g. CPU outside the process cpuset) the worker
+      keeps running unpinned.
+    - Starts num_threads workers, min_threads / max_threads make the pool
+      elastic (see ELASTIC SIZING).
 
 threadpool_execute
   Submit a job to the thread pool.
@@ -75,6 +122,44 @@ threadpool_execute
     - Non-blocking; will busy-wait internally only if the channel is full.
     - Jobs are executed in order of arrival by available workers.
     - Multiple producers can safely call this concurrently.
+    - Wakes at most one parked worker per job.
+    - Spawns a worker when none is parked, the backlog exceeds the number
+      of running workers and the pool is below max_workers.
+
+threadpool_execute_batch
+  Submits `count` jobs at once.
+
+  threadpool : pointer to a valid ThreadPool
+  jobs       : array of `count` jobs
+  count      : number of jobs
+
+  Notes:
+    - One channel claim for the whole array (see mpmc_send_batch) instead
+      of one per job.
+    - Wakes up to `count` parked workers with a single futex call.
+    - Same ordering guarantees as calling threadpool_execute in a loop.
+    - Returns the number of jobs queued, jobs[0, n): less than `count`
+      only if the pool is shut down meanwhile.
+
+threadpool_resize
+  Changes the sizing bounds of a running pool.
+
+  threadpool  : pointer to a valid ThreadPool
+  min_workers : workers kept alive even when idle (>= 1)
+  max_workers : upper bound for growth (<= num_workers)
+
+  Returns 0 on success, -1 if the bounds are invalid or min_workers
+  workers could not be started (the previous bounds are kept then).
+
+  Notes:
+    - Spawns workers right away up to min_workers.
+    - Workers above max_workers exit the next time they go idle; a worker
+      never abandons a running job.
+    - Pass the same value twice for a fixed size, e.g. all cores while
+      loading, then resize(pool, 2, 4) for gameplay.
+
+threadpool_num_workers
+  Returns the number of running workers.
 
 threadpool_shutdown
   Gracefully shuts down the thread pool.
@@ -83,18 +168,66 @@ threadpool_shutdown
 
   Notes:
     - Closes the dispatcher and underlying channel.
+    - Wakes every parked worker so it can drain the queue and exit.
     - Joins all worker threads, waiting for them to finish.
     - Frees all associated memory.
-    - After this call, the ThreadPool pointer becomes invalid.*/
+    - After this call, the ThreadPool pointer becomes invalid.
+
+------------------------------------------------------------------------------
+IDLE PARKING
+
+A worker that finds the queue empty spins THREADPOOL_SPIN_LIMIT times with
+cpu_relax(), then sleeps on the pool's ChannelSignal (a futex on Linux). An
+idle pool therefore costs no CPU. Every submitted job bumps the signal and
+wakes at most one sleeper; the bump also stops a worker that is about to
+sleep, so no job is left behind with every worker parked.
+
+Raise THREADPOOL_SPIN_LIMIT (define it before including) for bursty
+workloads where the wake-up latency matters more than idle CPU time.
+
+------------------------------------------------------------------------------
+ELASTIC SIZING
+
+The pool allocates num_workers = max(num_threads, max_threads) slots up
+front and keeps between min_workers and max_workers of them running:
+  - grow   : on submit, when no worker is parked and the queue holds more
+             jobs than there are running workers, one worker is spawned.
+  - shrink : a worker above min_workers that stays parked for the idle
+             timeout exits; workers above max_workers exit as soon as they
+             find the queue empty.
+Exited workers are joined lazily, when their slot is reused or at
+shutdown. Resizing never blocks submitters.*/
 
 #ifndef THREADPOOL_H
 #define THREADPOOL_H
 
 #include <pthread.h>
+#include <stdint.h>
 
 typedef struct ReceiverMpmc_t ReceiverMpmc;
 typedef struct SenderMpmc_t SenderMpmc;
 typedef struct ChannelMpmc_t ChannelMpmc;
+typedef struct CpuTopology_t CpuTopology;
+typedef struct ThreadPool_t ThreadPool;
+
+// empty polls before an idle worker parks
+#ifndef THREADPOOL_SPIN_LIMIT
+#define THREADPOOL_SPIN_LIMIT 4096
+#endif
+
+// yields threadpool_resize waits for a slot an exiting worker still holds
+#ifndef THREADPOOL_SPAWN_RETRIES
+#define THREADPOOL_SPAWN_RETRIES 4096
+#endif
+
+// parked time after which a worker above min_workers exits
+#ifndef THREADPOOL_IDLE_TIMEOUT_MS
+#define THREADPOOL_IDLE_TIMEOUT_MS 250
+#endif
+
+#define THREADPOOL_SLOT_FREE 0
+#define THREADPOOL_SLOT_LIVE 1
+#define THREADPOOL_SLOT_EXITED 2
 
 typedef void *(*__job)(void *);
 
@@ -103,10 +236,21 @@ typedef struct Job_t {
   void *arg;
 } __Job__;
 
+typedef struct WorkerPlacement_t {
+  int cpu;       // -1 for no pinning
+  int node;      // -1 to keep the default memory policy
+  char name[16]; // empty keeps the default thread name
+} WorkerPlacement;
+
 typedef struct Worker_t {
   ReceiverMpmc *receiver;
   SenderMpmc *sender;
   ChannelMpmc *chan_ref;
+  ChannelSignal *idle;
+  ThreadPool *pool;
+
+  WorkerPlacement place;
+  size_t id;
 } Worker;
 
 typedef struct ThreadPool_t {
@@ -115,43 +259,364 @@ typedef struct ThreadPool_t {
 
   ChannelMpmc *channel;
   SenderMpmc *dispatcher;
+  size_t queue_capacity;
+
+  ChannelSignal idle;
 
+  _Atomic uint8_t *slot_state;
+  WorkerPlacement *placement;
+  void *(*entry)(void *);
+  size_t (*backlog)(ThreadPool *tp); // queued work, drives elastic growth
+  int64_t idle_timeout_ns;
+
+  _Atomic size_t min_workers;
+  _Atomic size_t max_workers;
+  _Atomic size_t live_workers;
+  _Atomic size_t idle_workers;
+  _Atomic uint8_t resizing; // 1 while a thread spawns or joins workers
 } ThreadPool;
 
+typedef struct ThreadPoolOptions_t {
+  const int *cpus;
+  size_t num_cpus;
+  uint8_t pin;
+  uint8_t avoid_smt;
+  const int *exclude;
+  size_t num_exclude;
+  uint8_t numa_local;
+  const char *name;
+
+  size_t min_threads;
+  size_t max_threads;
+  uint32_t idle_timeout_ms;
+} ThreadPoolOptions;
+
 ThreadPool *threadpool_init(size_t num_threads);
+ThreadPool *threadpool_init_ex(size_t num_threads,
+                               const ThreadPoolOptions *opts);
 void threadpool_execute(ThreadPool *threadpool, __job __func, void *arg);
+size_t threadpool_execute_batch(ThreadPool *threadpool, const __Job__ *jobs,
+                                size_t count);
+int threadpool_resize(ThreadPool *threadpool, size_t min_workers,
+                      size_t max_workers);
+size_t threadpool_num_workers(ThreadPool *threadpool);
 
 void threadpool_shutdown(ThreadPool *threadpool);
 
+// internal: shared with the job system workers
+typedef int (*_threadpool_poll)(Worker *worker, void *out);
+ThreadPool *_threadpool_alloc(size_t num_threads,
+                              const ThreadPoolOptions *opts,
+                              void *(*entry)(void *));
+void _threadpool_start(ThreadPool *tp, size_t num_threads);
+void _threadpool_maybe_grow(ThreadPool *tp, size_t backlog);
+size_t _threadpool_send_batch(ThreadPool *tp, const void *elements,
+                              size_t count, size_t elem_size);
+int _threadpool_worker_next(Worker *worker, void *out, _threadpool_poll poll);
+void _threadpool_worker_setup(const Worker *worker);
+void _threadpool_worker_exit(Worker *worker);
+
 #endif
 
 #if (defined(THREADPOOL_IMPLEMENTATION))
+#include <sched.h>
 #include <stdatomic.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 static void *__set_worker(void *arg);
+static int _threadpool_poll_channel(Worker *worker, void *out);
+static void _threadpool_plan(ThreadPool *tp, const ThreadPoolOptions *opts);
 
 ThreadPool *threadpool_init(size_t num_threads) {
-  ThreadPool *tp = malloc(sizeof(ThreadPool));
+  return threadpool_init_ex(num_threads, NULL);
+}
 
-  tp->workers = malloc(num_threads * sizeof(pthread_t));
-  tp->num_workers = num_threads;
+ThreadPool *threadpool_init_ex(size_t num_threads,
+                               const ThreadPoolOptions *opts) {
+  ThreadPool *tp = _threadpool_alloc(num_threads, opts, __set_worker);
 
-  tp->channel = channel_create_mpmc(num_threads * 4, sizeof(__Job__));
+  tp->queue_capacity = tp->num_workers * 4;
+  tp->channel = channel_create_mpmc(tp->queue_capacity, sizeof(__Job__));
   tp->dispatcher = mpmc_get_sender(tp->channel);
 
-  for (size_t i = 0; i < num_threads; i++) {
+  _threadpool_start(tp, num_threads);
+
+  return tp;
+}
+
+// Default backlog hook: jobs waiting in the pool channel (0 without one).
+static size_t _threadpool_channel_backlog(ThreadPool *tp) {
+  return mpmc_len(tp->channel);
+}
+
+// Allocates a pool and its worker slots without starting any thread, the
+// caller creates the channel / dispatcher (or leaves them NULL when its poll
+// function reads another queue, then it also replaces tp->backlog) and then
+// calls _threadpool_start.
+ThreadPool *_threadpool_alloc(size_t num_threads,
+                              const ThreadPoolOptions *opts,
+                              void *(*entry)(void *)) {
+  ThreadPool *tp = malloc(sizeof(ThreadPool));
+
+  size_t min = num_threads;
+  size_t max = num_threads;
+  int64_t timeout_ms = THREADPOOL_IDLE_TIMEOUT_MS;
+  if (opts) {
+    if (opts->min_threads > 0 && opts->min_threads < min) {
+      min = opts->min_threads;
+    }
+    if (opts->max_threads > max) {
+      max = opts->max_threads;
+    }
+    if (opts->idle_timeout_ms > 0) {
+      timeout_ms = opts->idle_timeout_ms;
+    }
+  }
+
+  tp->workers = malloc(max * sizeof(pthread_t));
+  tp->num_workers = max;
+  tp->slot_state = malloc(max * sizeof(_Atomic uint8_t));
+  for (size_t i = 0; i < max; i++) {
+    atomic_init(&tp->slot_state[i], THREADPOOL_SLOT_FREE);
+  }
+  tp->placement = malloc(max * sizeof(WorkerPlacement));
+  tp->entry = entry;
+  tp->backlog = _threadpool_channel_backlog;
+  tp->idle_timeout_ns = timeout_ms * 1000000;
+
+  tp->channel = NULL;
+  tp->dispatcher = NULL;
+  tp->queue_capacity = 0;
+  channel_signal_init(&tp->idle);
+
+  atomic_init(&tp->min_workers, min);
+  atomic_init(&tp->max_workers, max);
+  atomic_init(&tp->live_workers, 0);
+  atomic_init(&tp->idle_workers, 0);
+  atomic_init(&tp->resizing, 0);
+
+  _threadpool_plan(tp, opts);
+  return tp;
+}
+
+// Resolves each slot's CPU / node / name from `opts`.
+static void _threadpool_plan(ThreadPool *tp, const ThreadPoolOptions *opts) {
+  CpuTopology *topo = NULL;
+  int *picked = NULL;
+  size_t num_picked = 0;
+
+  if (opts && (opts->cpus || opts->pin || opts->numa_local)) {
+    topo = malloc(sizeof(CpuTopology));
+    topology_discover(topo);
+    if (!opts->cpus && opts->pin) {
+      picked = malloc(topo->num_cpus * sizeof(int));
+      num_picked =
+          topology_select_cpus(topo, opts->avoid_smt, opts->exclude,
+                               opts->num_exclude, picked, topo->num_cpus);
+    }
+  }
+
+  for (size_t i = 0; i < tp->num_workers; i++) {
+    WorkerPlacement *place = &tp->placement[i];
+    place->cpu = -1;
+    place->node = -1;
+    place->name[0] = '\0';
+
+    if (opts) {
+      if (opts->cpus && opts->num_cpus > 0) {
+        place->cpu = opts->cpus[i % opts->num_cpus];
+      } else if (num_picked > 0) {
+        place->cpu = picked[i % num_picked];
+      }
+      if (opts->numa_local && place->cpu >= 0) {
+        place->node = topology_cpu_node(topo, place->cpu);
+      }
+      if (opts->name) {
+        // the kernel keeps 15 characters, cut the prefix rather than the index
+        char index[24];
+        size_t len = (size_t)snprintf(index, sizeof(index), "-%zu", i);
+        size_t keep = strlen(opts->name);
+        if (keep + len > sizeof(place->name) - 1) {
+          keep = sizeof(place->name) - 1 - len;
+        }
+        memcpy(place->name, opts->name, keep);
+        memcpy(place->name + keep, index, len + 1);
+      }
+    }
+  }
+
+  free(picked);
+  free(topo);
+}
+
+static void _threadpool_lock(ThreadPool *tp) {
+  uint8_t expected = 0;
+  while (!atomic_compare_exchange_weak_explicit(&tp->resizing, &expected, 1,
+                                                memory_order_acquire,
+                                                memory_order_relaxed)) {
+    expected = 0;
+    sched_yield();
+  }
+}
+
+static void _threadpool_unlock(ThreadPool *tp) {
+  atomic_store_explicit(&tp->resizing, 0, memory_order_release);
+}
+
+// Starts a worker in a FREE or EXITED slot. Caller holds the resizing flag.
+// Returns 0, 1 if every slot is still running or -1 if pthread_create
+// failed.
+static int _threadpool_spawn_one(ThreadPool *tp) {
+  for (size_t i = 0; i < tp->num_workers; i++) {
+    uint8_t state =
+        atomic_load_explicit(&tp->slot_state[i], memory_order_acquire);
+    if (state == THREADPOOL_SLOT_LIVE) {
+      continue;
+    }
+    if (state == THREADPOOL_SLOT_EXITED) {
+      pthread_join(tp->workers[i], NULL);
+    }
+
     Worker *worker = malloc(sizeof(Worker));
     worker->receiver = mpmc_get_receiver(tp->channel);
     worker->sender = mpmc_get_sender(tp->channel);
     worker->chan_ref = tp->channel;
+    worker->idle = &tp->idle;
+    worker->pool = tp;
+    worker->place = tp->placement[i];
+    worker->id = i;
+
+    atomic_store_explicit(&tp->slot_state[i], THREADPOOL_SLOT_LIVE,
+                          memory_order_relaxed);
+    atomic_fetch_add_explicit(&tp->live_workers, 1, memory_order_acq_rel);
+    if (pthread_create(&tp->workers[i], NULL, tp->entry, worker) != 0) {
+      atomic_fetch_sub_explicit(&tp->live_workers, 1, memory_order_acq_rel);
+      atomic_store_explicit(&tp->slot_state[i], THREADPOOL_SLOT_FREE,
+                            memory_order_relaxed);
+      mpmc_close_sender(worker->sender);
+      mpmc_close_receiver(worker->receiver);
+      free(worker->receiver);
+      free(worker->sender);
+      free(worker);
+      return -1;
+    }
+    return 0;
+  }
+  // every slot still running (some may be exiting right now)
+  return 1;
+}
 
-    pthread_create(&tp->workers[i], NULL, __set_worker, worker);
+void _threadpool_start(ThreadPool *tp, size_t num_threads) {
+  _threadpool_lock(tp);
+  for (size_t i = 0; i < num_threads && i < tp->num_workers; i++) {
+    _threadpool_spawn_one(tp);
   }
+  _threadpool_unlock(tp);
+}
 
-  return tp;
+// Called by submitters: spawns one worker if nobody is parked and the
+// backlog outnumbers the running workers. Cheap no-op for fixed pools.
+void _threadpool_maybe_grow(ThreadPool *tp, size_t backlog) {
+  size_t live = atomic_load_explicit(&tp->live_workers, memory_order_relaxed);
+  if (live >= atomic_load_explicit(&tp->max_workers, memory_order_relaxed) ||
+      backlog <= live ||
+      atomic_load_explicit(&tp->idle_workers, memory_order_relaxed) > 0) {
+    return;
+  }
+  // somebody else is resizing, they will see the same backlog
+  uint8_t expected = 0;
+  if (!atomic_compare_exchange_strong_explicit(&tp->resizing, &expected, 1,
+                                               memory_order_acquire,
+                                               memory_order_relaxed)) {
+    return;
+  }
+  if (atomic_load_explicit(&tp->live_workers, memory_order_acquire) <
+      atomic_load_explicit(&tp->max_workers, memory_order_acquire)) {
+    _threadpool_spawn_one(tp);
+  }
+  _threadpool_unlock(tp);
+}
+
+int threadpool_resize(ThreadPool *threadpool, size_t min_workers,
+                      size_t max_workers) {
+  if (!threadpool || min_workers == 0 || min_workers > max_workers ||
+      max_workers > threadpool->num_workers) {
+    return -1;
+  }
+
+  _threadpool_lock(threadpool);
+  size_t old_min =
+      atomic_load_explicit(&threadpool->min_workers, memory_order_relaxed);
+  size_t old_max =
+      atomic_load_explicit(&threadpool->max_workers, memory_order_relaxed);
+  atomic_store_explicit(&threadpool->min_workers, min_workers,
+                        memory_order_release);
+  atomic_store_explicit(&threadpool->max_workers, max_workers,
+                        memory_order_release);
+  size_t retries = 0;
+  while (atomic_load_explicit(&threadpool->live_workers,
+                              memory_order_acquire) < min_workers) {
+    int res = _threadpool_spawn_one(threadpool);
+    if (res == 0) {
+      continue;
+    }
+    if (res < 0 || ++retries > THREADPOOL_SPAWN_RETRIES) {
+      // can't reach min_workers: keep the old bounds, the workers started
+      // meanwhile retire once idle
+      atomic_store_explicit(&threadpool->min_workers, old_min,
+                            memory_order_release);
+      atomic_store_explicit(&threadpool->max_workers, old_max,
+                            memory_order_release);
+      _threadpool_unlock(threadpool);
+      channel_signal_notify(&threadpool->idle);
+      return -1;
+    }
+    // a slot is still being vacated by an exiting worker
+    sched_yield();
+  }
+  _threadpool_unlock(threadpool);
+
+  // parked workers re-check the new bounds: above max they exit now, above
+  // min they start their idle timeout
+  channel_signal_notify(&threadpool->idle);
+  return 0;
+}
+
+size_t threadpool_num_workers(ThreadPool *threadpool) {
+  return atomic_load_explicit(&threadpool->live_workers,
+                              memory_order_acquire);
+}
+
+// Runs on the worker thread itself so the affinity and memory policy apply
+// to it, not to the thread creating the pool.
+void _threadpool_worker_setup(const Worker *worker) {
+  if (worker->place.cpu >= 0) {
+    topology_pin_current_thread(worker->place.cpu);
+  }
+  if (worker->place.node >= 0) {
+    topology_bind_current_thread_memory(worker->place.node);
+  }
+  if (worker->place.name[0] != '\0') {
+    topology_name_current_thread(worker->place.name);
+  }
+}
+
+// Releases the worker's handles and marks its slot for joining.
+void _threadpool_worker_exit(Worker *worker) {
+  ThreadPool *tp = worker->pool;
+  size_t id = worker->id;
+
+  mpmc_close_sender(worker->sender);
+  mpmc_close_receiver(worker->receiver);
+  free(worker->receiver);
+  free(worker->sender);
+  free(worker);
+
+  atomic_store_explicit(&tp->slot_state[id], THREADPOOL_SLOT_EXITED,
+                        memory_order_release);
 }
 
 void threadpool_execute(ThreadPool *threadpool, __job __func, void *arg) {
@@ -160,16 +625,61 @@ void threadpool_execute(ThreadPool *threadpool, __job __func, void *arg) {
   job.arg = arg;
 
   mpmc_send(threadpool->dispatcher, &job);
+  channel_signal_notify_n(&threadpool->idle, 1);
+  _threadpool_maybe_grow(threadpool, threadpool->backlog(threadpool));
 };
 
+size_t threadpool_execute_batch(ThreadPool *threadpool, const __Job__ *jobs,
+                                size_t count) {
+  return _threadpool_send_batch(threadpool, jobs, count, sizeof(__Job__));
+}
+
+// Sends in chunks of at most the queue capacity and wakes workers after
+// each one: a chunk can only wait on slots holding jobs from before it,
+// which were already announced, so parked workers never stall the batch.
+// Returns the number of elements queued, it stops at the first chunk the
+// closed channel cut short.
+size_t _threadpool_send_batch(ThreadPool *tp, const void *elements,
+                              size_t count, size_t elem_size) {
+  const uint8_t *next = elements;
+  size_t total = 0;
+  while (count > 0) {
+    size_t chunk = count < tp->queue_capacity ? count : tp->queue_capacity;
+    size_t sent = 0;
+    int res = mpmc_send_batch(tp->dispatcher, next, chunk, &sent);
+    if (sent > 0) {
+      channel_signal_notify_n(&tp->idle, (uint32_t)(sent > UINT32_MAX
+                                                        ? UINT32_MAX
+                                                        : sent));
+      _threadpool_maybe_grow(tp, tp->backlog(tp));
+    }
+    total += sent;
+    if (res != CHANNEL_OK) {
+      break;
+    }
+    next += chunk * elem_size;
+    count -= chunk;
+  }
+  return total;
+}
+
 void threadpool_shutdown(ThreadPool *threadpool) {
+  // taken for good, no worker is spawned past this point
+  _threadpool_lock(threadpool);
+
   mpmc_close_sender(threadpool->dispatcher);
   mpmc_close(threadpool->channel);
+  channel_signal_notify(&threadpool->idle);
   for (size_t x = 0; x < threadpool->num_workers; x++) {
-    pthread_join(threadpool->workers[x], NULL);
+    if (atomic_load_explicit(&threadpool->slot_state[x],
+                             memory_order_acquire) != THREADPOOL_SLOT_FREE) {
+      pthread_join(threadpool->workers[x], NULL);
+    }
   }
   mpmc_destroy(threadpool->channel);
   free(threadpool->workers);
+  free((void *)threadpool->slot_state);
+  free(threadpool->placement);
   free(threadpool->dispatcher);
   free(threadpool);
 };
@@ -177,19 +687,84 @@ void threadpool_shutdown(ThreadPool *threadpool) {
 static void *__set_worker(void *arg) {
   Worker *worker = (Worker *)arg;
   __Job__ job;
-  while (1) {
-    if (mpmc_recv(worker->receiver, &job) == CHANNEL_OK) {
-      job.job(job.arg);
-    } else if (mpmc_is_closed(worker->chan_ref) == CLOSED) {
-      break;
-    }
+  _threadpool_worker_setup(worker);
+  while (_threadpool_worker_next(worker, &job, _threadpool_poll_channel) ==
+         CHANNEL_OK) {
+    job.job(job.arg);
   }
 
-  mpmc_close_sender(worker->sender);
-  mpmc_close_receiver(worker->receiver);
-  free(worker->receiver);
-  free(worker->sender);
-  free(worker);
+  _threadpool_worker_exit(worker);
   return NULL;
 };
+
+static int _threadpool_poll_channel(Worker *worker, void *out) {
+  return mpmc_try_recv(worker->receiver, out);
+}
+
+// Gives up the caller's place in the pool if more than `floor` workers run.
+static int _threadpool_retire(ThreadPool *tp, size_t floor) {
+  size_t live = atomic_load_explicit(&tp->live_workers, memory_order_acquire);
+  while (live > floor) {
+    if (atomic_compare_exchange_weak_explicit(&tp->live_workers, &live,
+                                              live - 1, memory_order_acq_rel,
+                                              memory_order_acquire)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Polls for work with `poll` (CHANNEL_OK / _EMPTY / _CLOSED, like
+// mpmc_try_recv), spinning for a while on empty, then parks on the pool's
+// idle signal. Returns CHANNEL_OK with a job in `out`, or CHANNEL_ERR_CLOSED
+// once there is no work left and the channel is closed, or when the worker
+// should exit because the pool shrinks.
+int _threadpool_worker_next(Worker *worker, void *out, _threadpool_poll poll) {
+  ThreadPool *tp = worker->pool;
+  size_t spins = 0;
+  for (;;) {
+    int res = poll(worker, out);
+    if (res == CHANNEL_OK &&
+        atomic_load_explicit(&tp->live_workers, memory_order_relaxed) <
+            atomic_load_explicit(&tp->max_workers, memory_order_relaxed)) {
+      // submitters skip growing while someone is parked, workers that find
+      // a backlog grow the pool on their behalf
+      _threadpool_maybe_grow(tp, tp->backlog(tp));
+    }
+    if (res != CHANNEL_ERR_EMPTY) {
+      return res;
+    }
+    if (spins < THREADPOOL_SPIN_LIMIT) {
+      spins++;
+      cpu_relax();
+      continue;
+    }
+    if (_threadpool_retire(tp, atomic_load_explicit(&tp->max_workers,
+                                                    memory_order_acquire))) {
+      return CHANNEL_ERR_CLOSED;
+    }
+    // read the sequence before the last look, a submit after this point
+    // moves it and the wait returns immediately
+    uint32_t seen =
+        atomic_load_explicit(&worker->idle->seq, memory_order_seq_cst);
+    res = poll(worker, out);
+    if (res != CHANNEL_ERR_EMPTY) {
+      return res;
+    }
+
+    size_t min = atomic_load_explicit(&tp->min_workers, memory_order_acquire);
+    int64_t timeout =
+        atomic_load_explicit(&tp->live_workers, memory_order_acquire) > min
+            ? tp->idle_timeout_ns
+            : -1;
+    atomic_fetch_add_explicit(&tp->idle_workers, 1, memory_order_acq_rel);
+    res = channel_signal_wait(worker->idle, seen, timeout);
+    atomic_fetch_sub_explicit(&tp->idle_workers, 1, memory_order_acq_rel);
+
+    if (res == CHANNEL_ERR_EMPTY && _threadpool_retire(tp, min)) {
+      return CHANNEL_ERR_CLOSED;
+    }
+    spins = 0;
+  }
+};
 #endif
@@ -0,0 +1,375 @@
+// Copyright 2025 Seaker <seakerone@proton.me>
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/*------------------------------------------------------------------------------
+topology.h — CPU Topology Discovery and Thread Placement (Linux)
+
+Reads the CPU layout from /sys/devices/system/cpu so thread pools can pin
+workers to cores, skip SMT siblings and keep memory on the local NUMA node.
+Everything is plain syscalls, no libnuma / _GNU_SOURCE required.
+
+------------------------------------------------------------------------------
+STRUCTS
+
+CpuInfo:
+  One online logical CPU.
+  - cpu       : logical CPU id (as used by sched_setaffinity)
+  - core      : core id inside its package
+  - package   : physical package (socket) id
+  - node      : NUMA node, 0 when the kernel exposes no NUMA information
+  - smt_index : position among the core's hardware threads (0 = primary)
+
+CpuTopology:
+  - num_cpus     : online logical CPUs stored in `cpus`
+  - num_cores    : physical cores (CPUs with smt_index == 0)
+  - num_packages : sockets
+  - num_nodes    : NUMA nodes
+  - cpus         : CpuInfo array ordered by CPU id
+
+------------------------------------------------------------------------------
+FUNCTIONS
+
+topology_discover
+  Fills `topo` from /sys.
+
+  Returns 0 on success, -1 when /sys is unavailable (non-Linux, containers
+  without sysfs). On failure `topo` describes a single CPU 0.
+
+topology_select_cpus
+  Orders CPUs for worker placement: primary hardware threads first (one per
+  core), then SMT siblings unless `avoid_smt` is set. CPUs listed in
+  `exclude` are skipped (e.g. the core reserved for the input thread).
+
+  Returns the number of CPUs written to `out` (at most `max`).
+
+topology_cpu_node
+  Returns the NUMA node of `cpu`, or -1 if the CPU is unknown.
+
+topology_pin_current_thread
+  Restricts the calling thread to `cpu`. Returns 0 on success, -1 on failure.
+
+topology_bind_current_thread_memory
+  Makes future page allocations of the calling thread prefer `node`.
+  Returns 0 on success, -1 on failure (e.g. kernel without NUMA).
+
+topology_name_current_thread
+  Sets the thread name shown by top, perf, gdb and most profilers.
+  Names longer than 15 characters are truncated.
+
+------------------------------------------------------------------------------
+USAGE EXAMPLE
+
+  CpuTopology topo;
+  topology_discover(&topo);
+
+  // keep CPU 0 for the input thread, pool gets one thread per other core
+  int reserved[] = {0};
+  int cpus[TOPOLOGY_MAX_CPUS];
+  size_t n = topology_select_cpus(&topo, 1, reserved, 1, cpus,
+                                  TOPOLOGY_MAX_CPUS);
+
+  topology_pin_current_thread(0);
+  topology_name_current_thread("input");*/
+
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <stddef.h>
+
+#ifndef TOPOLOGY_MAX_CPUS
+#define TOPOLOGY_MAX_CPUS 512
+#endif
+
+typedef struct CpuInfo_t {
+  int cpu;
+  int core;
+  int package;
+  int node;
+  int smt_index;
+} CpuInfo;
+
+typedef struct CpuTopology_t {
+  size_t num_cpus;
+  size_t num_cores;
+  size_t num_packages;
+  size_t num_nodes;
+  CpuInfo cpus[TOPOLOGY_MAX_CPUS];
+} CpuTopology;
+
+int topology_discover(CpuTopology *topo);
+size_t topology_select_cpus(const CpuTopology *topo, int avoid_smt,
+                            const int *exclude, size_t num_exclude, int *out,
+                            size_t max);
+int topology_cpu_node(const CpuTopology *topo, int cpu);
+
+int topology_pin_current_thread(int cpu);
+int topology_bind_current_thread_memory(int node);
+int topology_name_current_thread(const char *name);
+
+#endif
+
+#if (defined(TOPOLOGY_IMPLEMENTATION))
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <stdlib.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// from linux/mempolicy.h, not every libc ships it
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+
+#define _TOPOLOGY_SYSFS "/sys/devices/system/cpu"
+
+// Reads a single integer from a sysfs file, -1 on failure.
+static int _topology_read_int(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    return -1;
+  }
+  int v = -1;
+  if (fscanf(f, "%d", &v) != 1) {
+    v = -1;
+  }
+  fclose(f);
+  return v;
+}
+
+// Parses a sysfs cpu list ("0-3,8,10-11") into `out`, returns the count.
+static size_t _topology_read_list(const char *path, int *out, size_t max) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    return 0;
+  }
+  size_t n = 0;
+  int lo, hi;
+  char sep;
+  while (fscanf(f, "%d", &lo) == 1) {
+    hi = lo;
+    sep = (char)fgetc(f);
+    if (sep == '-') {
+      if (fscanf(f, "%d", &hi) != 1) {
+        break;
+      }
+      sep = (char)fgetc(f);
+    }
+    for (int c = lo; c <= hi && n < max; c++) {
+      out[n++] = c;
+    }
+    if (sep != ',') {
+      break;
+    }
+  }
+  fclose(f);
+  return n;
+}
+
+#if defined(__linux__)
+// Finds the `nodeN` link inside a cpu directory, 0 if there is none.
+static int _topology_find_node(int cpu) {
+  char path[96];
+  snprintf(path, sizeof(path), _TOPOLOGY_SYSFS "/cpu%d", cpu);
+  DIR *dir = opendir(path);
+  if (!dir) {
+    return 0;
+  }
+  int node = 0;
+  struct dirent *ent;
+  while ((ent = readdir(dir)) != NULL) {
+    if (strncmp(ent->d_name, "node", 4) == 0 && ent->d_name[4] >= '0' &&
+        ent->d_name[4] <= '9') {
+      node = atoi(ent->d_name + 4);
+      break;
+    }
+  }
+  closedir(dir);
+  return node;
+}
+#endif
+
+int topology_discover(CpuTopology *topo) {
+  memset(topo, 0, sizeof(CpuTopology));
+
+  int online[TOPOLOGY_MAX_CPUS];
+  size_t n = _topology_read_list(_TOPOLOGY_SYSFS "/online", online,
+                                 TOPOLOGY_MAX_CPUS);
+#if defined(__linux__)
+  if (n == 0) {
+    long conf = sysconf(_SC_NPROCESSORS_ONLN);
+    for (long c = 0; c < conf && n < TOPOLOGY_MAX_CPUS; c++) {
+      online[n++] = (int)c;
+    }
+  }
+#endif
+  if (n == 0) {
+    topo->num_cpus = topo->num_cores = topo->num_packages = topo->num_nodes = 1;
+    return -1;
+  }
+
+  int max_package = 0, max_node = 0;
+  char path[128];
+  for (size_t i = 0; i < n; i++) {
+    CpuInfo *info = &topo->cpus[i];
+    int cpu = online[i];
+    info->cpu = cpu;
+
+    snprintf(path, sizeof(path), _TOPOLOGY_SYSFS "/cpu%d/topology/core_id",
+             cpu);
+    info->core = _topology_read_int(path);
+    if (info->core < 0) {
+      info->core = cpu;
+    }
+
+    snprintf(path, sizeof(path),
+             _TOPOLOGY_SYSFS "/cpu%d/topology/physical_package_id", cpu);
+    info->package = _topology_read_int(path);
+    if (info->package < 0) {
+      info->package = 0;
+    }
+
+    // the first sibling listed is the core's primary hardware thread
+    int siblings[64];
+    snprintf(path, sizeof(path),
+             _TOPOLOGY_SYSFS "/cpu%d/topology/thread_siblings_list", cpu);
+    size_t num_siblings = _topology_read_list(path, siblings, 64);
+    info->smt_index = 0;
+    for (size_t s = 0; s < num_siblings; s++) {
+      if (siblings[s] == cpu) {
+        info->smt_index = (int)s;
+        break;
+      }
+    }
+
+#if defined(__linux__)
+    info->node = _topology_find_node(cpu);
+#else
+    info->node = 0;
+#endif
+
+    if (info->smt_index == 0) {
+      topo->num_cores++;
+    }
+    if (info->package > max_package) {
+      max_package = info->package;
+    }
+    if (info->node > max_node) {
+      max_node = info->node;
+    }
+  }
+
+  topo->num_cpus = n;
+  topo->num_packages = (size_t)max_package + 1;
+  topo->num_nodes = (size_t)max_node + 1;
+  return 0;
+}
+
+static int _topology_excluded(int cpu, const int *exclude,
+                              size_t num_exclude) {
+  for (size_t i = 0; i < num_exclude; i++) {
+    if (exclude[i] == cpu) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+size_t topology_select_cpus(const CpuTopology *topo, int avoid_smt,
+                            const int *exclude, size_t num_exclude, int *out,
+                            size_t max) {
+  size_t n = 0;
+  // pass 0: primary threads, pass 1: SMT siblings
+  for (int pass = 0; pass < 2 && n < max; pass++) {
+    if (pass == 1 && avoid_smt) {
+      break;
+    }
+    for (size_t i = 0; i < topo->num_cpus && n < max; i++) {
+      const CpuInfo *info = &topo->cpus[i];
+      if ((pass == 0) != (info->smt_index == 0)) {
+        continue;
+      }
+      if (_topology_excluded(info->cpu, exclude, num_exclude)) {
+        continue;
+      }
+      out[n++] = info->cpu;
+    }
+  }
+  return n;
+}
+
+int topology_cpu_node(const CpuTopology *topo, int cpu) {
+  for (size_t i = 0; i < topo->num_cpus; i++) {
+    if (topo->cpus[i].cpu == cpu) {
+      return topo->cpus[i].node;
+    }
+  }
+  return -1;
+}
+
+int topology_pin_current_thread(int cpu) {
+#if defined(__linux__)
+  if (cpu < 0 || cpu >= TOPOLOGY_MAX_CPUS) {
+    return -1;
+  }
+  unsigned long mask[TOPOLOGY_MAX_CPUS / (8 * sizeof(unsigned long))];
+  memset(mask, 0, sizeof(mask));
+  mask[cpu / (8 * sizeof(unsigned long))] |=
+      1UL << (cpu % (8 * sizeof(unsigned long)));
+  return syscall(SYS_sched_setaffinity, 0, sizeof(mask), mask) == 0 ? 0 : -1;
+#else
+  (void)cpu;
+  return -1;
+#endif
+}
+
+int topology_bind_current_thread_memory(int node) {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+  if (node < 0 || node >= 63) {
+    return -1;
+  }
+  unsigned long mask = 1UL << node;
+  return syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask,
+                 8 * sizeof(mask)) == 0
+             ? 0
+             : -1;
+#else
+  (void)node;
+  return -1;
+#endif
+}
+
+int topology_name_current_thread(const char *name) {
+#if defined(__linux__)
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%s", name);
+  return prctl(PR_SET_NAME, buf, 0, 0, 0) == 0 ? 0 : -1;
+#else
+  (void)name;
+  return -1;
+#endif
+}
+#endif
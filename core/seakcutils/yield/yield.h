@@ -150,6 +150,19 @@ void g_anchor_init();
 // Safe to call only after all tasks have completed
 void g_anchor_free();
 
+// Low-level context switch, independent from the global anchor.
+// Saves the callee-saved registers on the current stack, stores the stack
+// pointer in `*from` and resumes the context saved in `to`.
+// Contexts are not tied to a thread: one saved on a thread may be resumed
+// on another (the job system's fibers rely on it).
+void __attribute__((naked)) yield_switch(void **from, void *to);
+
+// Prepares a context on `stack` (`size` bytes) that calls `entry(arg)` the
+// first time it is switched to, returns the value to pass to `yield_switch`.
+// `entry` must never return, it switches away instead.
+void *yield_make_context(void *stack, size_t size, void (*entry)(void *),
+                         void *arg);
+
 #endif // !YIELD_H
 
 #if (defined(YIELD_IMPLEMENTATION))
@@ -288,6 +301,52 @@ void switch_context(void *rsp) {
   remake_ctx(g_ctxs->ctxs[g_ctxs->index].rsp);
 }
 
+// naked: the arguments are only read from rdi / rsi by the asm
+void __attribute__((naked))
+yield_switch(void **from __attribute__((unused)),
+             void *to __attribute__((unused))) {
+  __asm__ __volatile__(
+      "pushq %rbp\n" // save callee-saved registers on the current stack
+      "pushq %rbx\n"
+      "pushq %r12\n"
+      "pushq %r13\n"
+      "pushq %r14\n"
+      "pushq %r15\n"
+      "movq %rsp, (%rdi)\n" // *from = rsp
+      "movq %rsi, %rsp\n"   // rsp = to
+      "popq %r15\n"
+      "popq %r14\n"
+      "popq %r13\n"
+      "popq %r12\n"
+      "popq %rbx\n"
+      "popq %rbp\n"
+      "ret\n");
+}
+
+// first frame of a context made by yield_make_context: entry in r13, its
+// argument in r12
+static void __attribute__((naked, used)) __yield_trampoline(void) {
+  __asm__ __volatile__("movq %r12, %rdi\n"
+                       "callq *%r13\n"
+                       "ud2\n"); // entry returned
+}
+
+void *yield_make_context(void *stack, size_t size, void (*entry)(void *),
+                         void *arg) {
+  uintptr_t top = (uintptr_t)stack + size;
+  top &= ~0xF; // align to 16 bytes
+  void **rsp = (void **)top;
+
+  *(--rsp) = (void *)__yield_trampoline; // ret
+  *(--rsp) = 0;                          // rbp
+  *(--rsp) = 0;                          // rbx
+  *(--rsp) = arg;                        // r12
+  *(--rsp) = (void *)entry;              // r13
+  *(--rsp) = 0;                          // r14
+  *(--rsp) = 0;                          // r15
+  return rsp;
+}
+
 void wait_for_tasks() {
   while (g_ctxs->count > 1) {
     yield();
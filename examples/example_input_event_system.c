@@ -17,7 +17,13 @@
 
 #include "../core/seakcutils/arenas/r_arena.h"
 #include "../core/seakcutils/channels/mpmc.h"
+#include "../core/seakcutils/channels/unbounded.h"
+#include "../core/seakcutils/data_structures/ws_deque.h"
+#if defined(JOBSYSTEM_FIBERS)
+#include "../core/seakcutils/yield/yield.h"
+#endif
 #include "../core/seakcutils/job_system/jobsystem.h"
+#include "../core/seakcutils/threadpool/topology.h"
 #include "../core/seakcutils/threadpool/threadpool.h"
 
 #include <stdio.h>